@@ -0,0 +1,347 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cc/backend/bench/synthetic_roms.h"
+#include "cc/backend/clocktroller/clocktroller.h"
+#include "cc/backend/debug/diagnostics.h"
+#include "cc/backend/debug/instrumentation.h"
+#include "cc/backend/debug/master.h"
+#include "cc/backend/debug/trace/trace_writer.h"
+#include "cc/backend/graphics/graphics_controller.h"
+#include "cc/backend/graphics/screen.h"
+#include "cc/backend/memory/mbc/rom_image.h"
+#include "cc/backend/memory/memory.h"
+#include "cc/backend/opcode_executor/opcode_executor.h"
+#include "cc/backend/scheduler/scheduler.h"
+#include "glog/logging.h"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+using backend::bench::BuildSyntheticROM;
+using backend::bench::SyntheticROMNames;
+using backend::clocktroller::RunCPUSlice;
+using backend::clocktroller::SkipWhileHalted;
+using backend::clocktroller::kMaxSlice;
+using backend::debug::Diagnostics;
+using backend::debug::Instrumentation;
+using backend::debug::Master;
+using backend::debug::trace::TraceWriter;
+using backend::graphics::DefaultRaster;
+using backend::graphics::Screen;
+using backend::graphics::ScreenRaster;
+using backend::graphics::kLargePeriod;
+using backend::memory::Memory;
+using backend::memory::ROMImage;
+using backend::opcode_executor::OpcodeExecutor;
+using backend::scheduler::Event;
+using backend::scheduler::Scheduler;
+
+typedef std::chrono::steady_clock Clock;
+
+static const int kClockSpeed = 4194304;
+// Thirty emulated seconds; the boot ROM alone takes about five.
+static const long kDefaultFrames = 1800;
+
+// Counts frames instead of showing them.
+class NullScreen : public Screen {
+ public:
+  void Draw() override { frames_drawn_++; }
+
+  ScreenRaster* mutable_raster() override { return &raster_; }
+
+  const ScreenRaster& raster() override { return raster_; }
+
+  long frames_drawn() const { return frames_drawn_; }
+
+ private:
+  DefaultRaster raster_;
+  long frames_drawn_ = 0;
+};
+
+struct Result {
+  string rom;
+  bool ok = true;
+  long frames = 0;
+  long frames_drawn = 0;
+  uint64_t cycles = 0;
+  long instructions = 0;
+  double seconds = 0;
+  // Time spent running instructions and time spent in scheduled events, which
+  // is split between the PPU, including drawing, and the timer.
+  double cpu_seconds = 0;
+  double event_seconds = 0;
+  double ppu_seconds = 0;
+  double timer_seconds = 0;
+
+  double mips() const { return instructions / seconds / 1e6; }
+  double fps() const { return frames / seconds; }
+  double speed() const { return cycles / static_cast<double>(kClockSpeed) / seconds; }
+};
+
+double Seconds(Clock::duration duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+// Time spent in each component's scheduled events.
+struct EventTimes {
+  Clock::duration ppu = Clock::duration(0);
+  Clock::duration timer = Clock::duration(0);
+};
+
+// Scheduler::RunDueEvents, timing each event. Each event ends the previous
+// one's timing, which keeps reading the clock down to once per event.
+void RunDueEvents(Scheduler* scheduler, EventTimes* times) {
+  Clock::time_point start = Clock::now();
+  while (true) {
+    const Event* event = scheduler->RunNextDueEvent();
+    if (event == nullptr) {
+      return;
+    }
+    Clock::time_point end = Clock::now();
+    Clock::duration duration = end - start;
+    start = end;
+    if (strcmp(event->name(), "ppu") == 0) {
+      times->ppu += duration;
+    } else if (strcmp(event->name(), "timer") == 0) {
+      times->timer += duration;
+    }
+  }
+}
+
+// Where the trace of rom goes when tracing to trace_prefix.
+string TracePath(const string& trace_prefix, const string& rom) {
+  string name = rom;
+  for (char& c : name) {
+    if (c == '/') {
+      c = '_';
+    }
+  }
+  return trace_prefix + name + ".trace";
+}
+
+// Runs rom for frames frames worth of clock cycles, boot ROM included. This is
+// the same loop as the Clocktroller's, just timed and on this thread. Every
+// instruction and memory access is traced if trace_prefix is not empty. Errors
+// logged by the emulated hardware are hidden unless verbose.
+Result Run(const string& name, shared_ptr<ROMImage> rom, long frames, const string& trace_prefix,
+           bool verbose) {
+  Result result;
+  result.rom = name;
+  result.frames = frames;
+
+  NullScreen screen;
+  Memory memory;
+  memory.Init(rom, &screen);
+  OpcodeExecutor opcode_executor(memory.memory_mapper(), memory.primary_flags());
+  Scheduler* scheduler = memory.scheduler();
+  // Destroyed before memory, which finishes the trace.
+  std::unique_ptr<Master> master;
+  if (!trace_prefix.empty()) {
+    master = std::unique_ptr<Master>(new Master());
+    master->Register(std::unique_ptr<TraceWriter>(new TraceWriter(TracePath(trace_prefix, name))));
+    master->Own(memory.memory_mapper());
+  }
+
+  const uint64_t end = static_cast<uint64_t>(frames) * kLargePeriod;
+  // The boot ROM writes to the sound registers, which are not emulated yet,
+  // and every such write logs an error.
+  const int log_level = FLAGS_minloglevel;
+  if (!verbose) {
+    FLAGS_minloglevel = google::GLOG_FATAL;
+  }
+  Clock::duration cpu_time(0);
+  Clock::duration event_time(0);
+  EventTimes event_times;
+  Clock::time_point start = Clock::now();
+  while (scheduler->now() < end) {
+    Clock::time_point slice_start = Clock::now();
+    long instructions = RunCPUSlice(&opcode_executor, scheduler,
+                                    std::min<uint64_t>(kMaxSlice, end - scheduler->now()));
+    Clock::time_point events_start = Clock::now();
+    cpu_time += events_start - slice_start;
+    if (instructions < 0) {
+      result.ok = false;
+      break;
+    }
+    result.instructions += instructions;
+    RunDueEvents(scheduler, &event_times);
+    if (scheduler->now() < end) {
+      SkipWhileHalted(&opcode_executor, scheduler,
+                      std::min<uint64_t>(kMaxSlice, end - scheduler->now()),
+                      [scheduler, &event_times]() { RunDueEvents(scheduler, &event_times); });
+    }
+    event_time += Clock::now() - events_start;
+  }
+  memory.memory_mapper()->Flush();
+  result.seconds = Seconds(Clock::now() - start);
+  FLAGS_minloglevel = log_level;
+  if (!result.ok) {
+    LOG(ERROR) << name << " stopped on an error after " << scheduler->now() << " cycles.";
+  }
+  result.cpu_seconds = Seconds(cpu_time);
+  result.event_seconds = Seconds(event_time);
+  result.ppu_seconds = Seconds(event_times.ppu);
+  result.timer_seconds = Seconds(event_times.timer);
+  result.cycles = scheduler->now();
+  result.frames_drawn = screen.frames_drawn();
+  return result;
+}
+
+// s as a JSON string literal, quotes included.
+string JSONString(const string& s) {
+  string quoted = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+      quoted += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escape[7];
+      snprintf(escape, sizeof(escape), "\\u%04x", c);
+      quoted += escape;
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+void PrintJSON(const vector<Result>& results) {
+  printf("[\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& result = results[i];
+    printf("  {\"rom\": %s, \"ok\": %s, \"frames\": %ld, \"frames_drawn\": %ld, "
+           "\"cycles\": %llu, \"instructions\": %ld, \"seconds\": %.6f, "
+           "\"mips\": %.3f, \"fps\": %.2f, \"speed\": %.3f, "
+           "\"cpu_seconds\": %.6f, \"event_seconds\": %.6f, \"ppu_seconds\": %.6f, "
+           "\"timer_seconds\": %.6f}%s\n",
+           JSONString(result.rom).c_str(), result.ok ? "true" : "false", result.frames,
+           result.frames_drawn, static_cast<unsigned long long>(result.cycles),
+           result.instructions, result.seconds, result.mips(), result.fps(),
+           result.speed(), result.cpu_seconds, result.event_seconds,
+           result.ppu_seconds, result.timer_seconds, i + 1 < results.size() ? "," : "");
+  }
+  printf("]\n");
+}
+
+void PrintCSV(const vector<Result>& results) {
+  printf("rom,ok,frames,frames_drawn,cycles,instructions,seconds,mips,fps,speed,"
+         "cpu_seconds,event_seconds,ppu_seconds,timer_seconds\n");
+  for (const Result& result : results) {
+    printf("%s,%d,%ld,%ld,%llu,%ld,%.6f,%.3f,%.2f,%.3f,%.6f,%.6f,%.6f,%.6f\n",
+           result.rom.c_str(), result.ok, result.frames, result.frames_drawn,
+           static_cast<unsigned long long>(result.cycles), result.instructions,
+           result.seconds, result.mips(), result.fps(), result.speed(),
+           result.cpu_seconds, result.event_seconds, result.ppu_seconds,
+           result.timer_seconds);
+  }
+}
+
+void PrintUsage() {
+  printf("Usage: turbo_bench [--frames=N] [--format=json|csv] [--trace=PREFIX]\n");
+  printf("                   [--diagnostics=SUBSYSTEM,...] [--verbose] [ROM...]\n");
+  printf("Each ROM is a file or the name of a synthetic ROM; with no ROMs every\n");
+  printf("synthetic ROM is run:");
+  for (const string& name : SyntheticROMNames()) {
+    printf(" %s", name.c_str());
+  }
+  printf("\n");
+  printf("The time is split between running instructions (cpu_seconds) and\n");
+  printf("scheduled events (event_seconds), which are split in turn between the\n");
+  printf("PPU, drawing included, and the timer.\n");
+  printf("--trace writes a binary trace of each ROM to PREFIX<ROM>.trace.\n");
+  printf("--diagnostics records the named subsystems (cpu, interrupts, graphics,\n");
+  printf("vram, joypad or all) and prints the last of it to stderr. Only what was\n");
+  printf("compiled in with -DTURBO_SANTA_DIAGNOSTICS_LEVEL=1 or 2 is recorded.\n");
+  printf("--verbose logs the errors the emulated hardware reports, which are hidden\n");
+  printf("otherwise; every ROM reports the boot ROM's writes to the sound\n");
+  printf("registers, which are not emulated yet.\n");
+}
+
+int main(int argc, char* argv[]) {
+  google::InstallFailureSignalHandler();
+  // Loading and setting up each ROM logs at INFO, which would bury the
+  // results.
+  FLAGS_minloglevel = google::GLOG_WARNING;
+
+  long frames = kDefaultFrames;
+  bool csv = false;
+  string trace_prefix;
+  bool diagnostics = false;
+  bool verbose = false;
+  vector<string> roms;
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg.compare(0, 9, "--frames=") == 0) {
+      frames = atol(arg.c_str() + 9);
+    } else if (arg == "--format=csv") {
+      csv = true;
+    } else if (arg == "--format=json") {
+      csv = false;
+    } else if (arg.compare(0, 8, "--trace=") == 0) {
+      trace_prefix = arg.substr(8);
+    } else if (arg.compare(0, 14, "--diagnostics=") == 0) {
+      if (!Diagnostics::EnableByName(arg.substr(14))) {
+        PrintUsage();
+        return -1;
+      }
+      diagnostics = true;
+    } else if (arg == "--verbose") {
+      verbose = true;
+    } else if (arg.compare(0, 2, "--") == 0) {
+      PrintUsage();
+      return -1;
+    } else {
+      roms.push_back(arg);
+    }
+  }
+  if (frames <= 0) {
+    PrintUsage();
+    return -1;
+  }
+  if (roms.empty()) {
+    roms = SyntheticROMNames();
+  }
+  if (!trace_prefix.empty()) {
+    Instrumentation::set_enabled(Instrumentation::MEMORY_READ, true);
+    Instrumentation::set_enabled(Instrumentation::MEMORY_WRITE, true);
+    Instrumentation::set_enabled(Instrumentation::OPCODE_EXECUTOR, true);
+  }
+
+  vector<Result> results;
+  for (const string& rom : roms) {
+    vector<uint8_t> data = BuildSyntheticROM(rom);
+    shared_ptr<ROMImage> image;
+    if (data.empty()) {
+      image = ROMImage::Map(rom);
+      if (image == nullptr) {
+        LOG(FATAL) << "Cannot read ROM " << rom;
+      }
+    } else {
+      image = ROMImage::Copy(data.data(), data.size());
+    }
+    results.push_back(Run(rom, image, frames, trace_prefix, verbose));
+  }
+
+  if (csv) {
+    PrintCSV(results);
+  } else {
+    PrintJSON(results);
+  }
+  if (diagnostics) {
+    Diagnostics::Dump(&std::cerr);
+  }
+  for (const Result& result : results) {
+    if (!result.ok) {
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "cc/backend/graphics/pixel_kernels.h"
+
+using std::vector;
+using backend::graphics::PixelKernels;
+using backend::graphics::SupportedKernels;
+
+typedef std::chrono::steady_clock Clock;
+
+// A frame's worth of each kind of work.
+static const int kLines = 144;
+static const int kLineWidth = 160;
+static const int kSpritesPerLine = 10;
+static const int kTileRows = 384 * 8;
+static const int kDefaultFrames = 20000;
+
+// Keeps the compiler from dropping work whose results are never read.
+static volatile uint8_t sink;
+
+double NanosecondsPerFrame(Clock::duration duration, int frames) {
+  return std::chrono::duration<double, std::nano>(duration).count() / frames;
+}
+
+int main(int argc, char* argv[]) {
+  const int frames = argc > 1 ? atoi(argv[1]) : kDefaultFrames;
+  vector<uint8_t> indices(kLines * kLineWidth);
+  vector<uint8_t> bitplanes(kTileRows * 2);
+  for (uint8_t& index : indices) {
+    index = rand() % 4;
+  }
+  for (uint8_t& byte : bitplanes) {
+    byte = rand();
+  }
+  const uint8_t shades[4] = {0, 64, 128, 192};
+  vector<uint8_t> out(kLines * kLineWidth);
+
+  // Nanoseconds per frame of: every background line shaded, ten sprites
+  // drawn on every line, and every tile in VRAM decoded.
+  printf("kernels,background_ns,sprites_ns,decode_ns\n");
+  for (const PixelKernels* kernels : SupportedKernels()) {
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+      for (int y = 0; y < kLines; y++) {
+        kernels->map_shades(&indices[y * kLineWidth], kLineWidth, shades, &out[y * kLineWidth]);
+      }
+    }
+    const double background = NanosecondsPerFrame(Clock::now() - start, frames);
+    sink = out[0];
+
+    start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+      for (int y = 0; y < kLines; y++) {
+        for (int sprite = 0; sprite < kSpritesPerLine; sprite++) {
+          const int x = sprite * 16;
+          kernels->map_sprite_shades(&indices[y * kLineWidth + x], &indices[y * kLineWidth + kLineWidth - 8 - x],
+                                     8, (sprite & 1) != 0, shades, &out[y * kLineWidth + x]);
+        }
+      }
+    }
+    const double sprites = NanosecondsPerFrame(Clock::now() - start, frames);
+    sink = out[0];
+
+    start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+      for (int row = 0; row < kTileRows; row++) {
+        kernels->decode_row(bitplanes[row * 2], bitplanes[row * 2 + 1], &out[(row * 8) % (out.size() - 8)]);
+      }
+    }
+    const double decode = NanosecondsPerFrame(Clock::now() - start, frames);
+    sink = out[0];
+
+    printf("%s,%.0f,%.0f,%.0f\n", kernels->name, background, sprites, decode);
+  }
+  return 0;
+}
@@ -0,0 +1,122 @@
+#include "cc/backend/bench/synthetic_roms.h"
+
+#include <map>
+
+namespace backend {
+namespace bench {
+
+using std::map;
+using std::string;
+using std::vector;
+
+namespace {
+
+const int kROMSize = 0x8000;
+const int kEntryPoint = 0x100;
+const int kNintendoLogoStartPosition = 0x104;
+const int kHeaderChecksumStart = 0x134;
+const int kHeaderChecksumPosition = 0x14d;
+const int kProgramStart = 0x150;
+const int kVBlankHandler = 0x40;
+
+const vector<uint8_t> kNintendoLogo = {
+    0xce, 0xed, 0x66, 0x66, 0xcc, 0x0d, 0x00, 0x0b,
+    0x03, 0x73, 0x00, 0x83, 0x00, 0x0c, 0x00, 0x0d,
+    0x00, 0x08, 0x11, 0x1f, 0x88, 0x89, 0x00, 0x0e,
+    0xdc, 0xcc, 0x6e, 0xe6, 0xdd, 0xdd, 0xd9, 0x99,
+    0xbb, 0xbb, 0x67, 0x63, 0x6e, 0x0e, 0xec, 0xcc,
+    0xdd, 0xdc, 0x99, 0x9f, 0xbb, 0xb9, 0x33, 0x3e
+};
+
+const vector<uint8_t> kALULoop = {
+    0x3c,             // 0x150: INC A
+    0xea, 0x00, 0xc0, // 0x151: LD (0xc000), A
+    0x80,             // 0x154: ADD A, B
+    0x0d,             // 0x155: DEC C
+    0x20, 0xf8,       // 0x156: JR NZ, 0x150
+    0x04,             // 0x158: INC B
+    0xc3, 0x50, 0x01, // 0x159: JP 0x150
+};
+
+const vector<uint8_t> kHaltVBlank = {
+    0x3e, 0x01,       // 0x150: LD A, 0x01
+    0xe0, 0xff,       // 0x152: LDH (0xff), A ; Only enable V blank.
+    0xfb,             // 0x154: EI
+    0x76,             // 0x155: HALT
+    0x18, 0xfd,       // 0x156: JR 0x155
+};
+
+const vector<uint8_t> kCountVBlanks = {
+    0x21, 0x00, 0xc0, // 0x40: LD HL, 0xc000
+    0x34,             // 0x43: INC (HL)
+    0xd9,             // 0x44: RETI
+};
+
+const vector<uint8_t> kVRAMCopy = {
+    0x21, 0x00, 0x00, // 0x150: LD HL, 0x0000
+    0x11, 0x00, 0x80, // 0x153: LD DE, 0x8000
+    0x01, 0x00, 0x10, // 0x156: LD BC, 0x1000
+    0x2a,             // 0x159: LD A, (HL+)
+    0x12,             // 0x15a: LD (DE), A
+    0x13,             // 0x15b: INC DE
+    0x0b,             // 0x15c: DEC BC
+    0x78,             // 0x15d: LD A, B
+    0xb1,             // 0x15e: OR C
+    0x20, 0xf8,       // 0x15f: JR NZ, 0x159
+    0xc3, 0x50, 0x01, // 0x161: JP 0x150
+};
+
+void Copy(const vector<uint8_t>& code, int address, vector<uint8_t>* rom) {
+  for (size_t i = 0; i < code.size(); i++) {
+    (*rom)[address + i] = code[i];
+  }
+}
+
+// Builds a 32KB ROM without an MBC which jumps from the entry point to
+// program.
+vector<uint8_t> BuildROM(const vector<uint8_t>& program) {
+  vector<uint8_t> rom(kROMSize, 0x00);
+  Copy({0x00, 0xc3, 0x50, 0x01}, kEntryPoint, &rom); // NOP; JP 0x150
+  Copy(kNintendoLogo, kNintendoLogoStartPosition, &rom);
+  // The boot ROM locks up unless 0x19 + the sum of 0x134-0x14d is zero.
+  uint8_t checksum = 0;
+  for (int i = kHeaderChecksumStart; i < kHeaderChecksumPosition; i++) {
+    checksum -= rom[i] + 1;
+  }
+  rom[kHeaderChecksumPosition] = checksum;
+  Copy(program, kProgramStart, &rom);
+  return rom;
+}
+
+const map<string, vector<uint8_t>>& SyntheticROMs() {
+  static const map<string, vector<uint8_t>>* roms = [] {
+    auto* roms = new map<string, vector<uint8_t>>();
+    (*roms)["alu_loop"] = BuildROM(kALULoop);
+    (*roms)["halt_vblank"] = BuildROM(kHaltVBlank);
+    Copy(kCountVBlanks, kVBlankHandler, &(*roms)["halt_vblank"]);
+    (*roms)["vram_copy"] = BuildROM(kVRAMCopy);
+    return roms;
+  }();
+  return *roms;
+}
+
+} // namespace
+
+vector<string> SyntheticROMNames() {
+  vector<string> names;
+  for (const auto& rom : SyntheticROMs()) {
+    names.push_back(rom.first);
+  }
+  return names;
+}
+
+vector<uint8_t> BuildSyntheticROM(const string& name) {
+  auto rom = SyntheticROMs().find(name);
+  if (rom == SyntheticROMs().end()) {
+    return {};
+  }
+  return rom->second;
+}
+
+} // namespace bench
+} // namespace backend
@@ -0,0 +1,25 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_BENCH_SYNTHETIC_ROMS_H_
+#define TURBO_SANTA_COMMON_BACK_END_BENCH_SYNTHETIC_ROMS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace backend {
+namespace bench {
+
+// Small ROMs built in code so that the benchmark can be run without any game
+// on disk. Each one has a valid header, so it runs through the boot ROM, and
+// then loops forever exercising one part of the emulator:
+//   alu_loop:    arithmetic and WRAM writes; mostly the CPU.
+//   halt_vblank: HALT waiting on the V blank interrupt, like most games do.
+//   vram_copy:   copying ROM into VRAM while the LCD is on.
+std::vector<std::string> SyntheticROMNames();
+
+// Returns an empty vector if there is no synthetic ROM called name.
+std::vector<uint8_t> BuildSyntheticROM(const std::string& name);
+
+} // namespace bench
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_BENCH_SYNTHETIC_ROMS_H_
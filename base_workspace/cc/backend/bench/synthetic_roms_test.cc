@@ -0,0 +1,32 @@
+#include <string>
+#include <vector>
+
+#include "cc/backend/bench/synthetic_roms.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace bench {
+
+using std::string;
+using std::vector;
+
+TEST(SyntheticROMsTest, HeaderChecksum) {
+  for (const string& name : SyntheticROMNames()) {
+    vector<uint8_t> rom = BuildSyntheticROM(name);
+    ASSERT_EQ(0x8000u, rom.size()) << name;
+    uint8_t sum = 0x19;
+    for (int i = 0x134; i <= 0x14d; i++) {
+      sum += rom[i];
+    }
+    EXPECT_EQ(0, sum) << name;
+    // NOP; JP 0x150
+    EXPECT_EQ(0xc3, rom[0x101]) << name;
+  }
+}
+
+TEST(SyntheticROMsTest, UnknownName) {
+  EXPECT_TRUE(BuildSyntheticROM("not_a_rom").empty());
+}
+
+} // namespace bench
+} // namespace backend
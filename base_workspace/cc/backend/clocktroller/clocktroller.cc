@@ -1,33 +1,63 @@
 #include "cc/backend/clocktroller/clocktroller.h"
 
-#include "cc/backend/debug/memory_profiler/memory_profiler.h"
+#include <algorithm>
+
+#include "cc/backend/graphics/graphics_controller.h"
 #include "glog/logging.h"
 
 namespace backend {
 namespace clocktroller {
 
+using std::shared_ptr;
 using std::unique_ptr;
 using debug::memory_profiler::MemoryProfiler;
 using graphics::GraphicsController;
 using memory::MemoryMapper;
+using memory::ROMImage;
 using opcode_executor::OpcodeExecutor;
 
+long RunCPUSlice(OpcodeExecutor* opcode_executor,
+                 scheduler::Scheduler* scheduler,
+                 uint64_t max_cycles) {
+  long instructions = 0;
+  // Nothing outside of the CPU changes until the next event is due.
+  uint64_t slice_end = scheduler->now() + max_cycles;
+  while (scheduler->now() < std::min(scheduler->next_deadline(), slice_end)) {
+    int ticks = opcode_executor->ReadInstruction();
+    if (ticks < 0) {
+      return -1;
+    }
+    instructions++;
+    scheduler->Advance(ticks);
+    if (opcode_executor->halted() && !opcode_executor->interrupt_pending()) {
+      // Only a scheduled event can wake the CPU now; see SkipWhileHalted.
+      scheduler->SkipTo(std::min(scheduler->next_deadline(), slice_end));
+    }
+  }
+  return instructions;
+}
 
-void Clocktroller::Init(unsigned char* rom, long length) {
-  memory_.Init(rom, length, screen_);
+void Clocktroller::Init(shared_ptr<ROMImage> rom) {
+  memory_.Init(rom, screen_);
   master_.Own(memory_.memory_mapper());
-  master_.Register(unique_ptr<MemoryProfiler>(new MemoryProfiler()));
+  memory_profiler_ = new MemoryProfiler();
+  master_.Register(unique_ptr<MemoryProfiler>(memory_profiler_));
   opcode_executor_ = unique_ptr<OpcodeExecutor>(
       new OpcodeExecutor(memory_.memory_mapper(), 
-                         memory_.primary_flags(), 
-                         memory_.internal_rom_flag()
-                         ));
-  opcode_executor_->Init();
+                         memory_.primary_flags()));
+}
+
+void Clocktroller::AttachPresenter(graphics::Presenter* presenter) {
+  memory_.graphics_controller()->AttachPresenter(presenter);
 }
 
 void Clocktroller::Run() {
-  is_paused_ = false;
-  is_dead_ = false;
+  {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    is_paused_ = false;
+    is_dead_ = false;
+  }
+  run_condition_.notify_one();
   if (!is_running_) {
     thread_ = std::thread([this]() { this->ExecutionLoop(); });
   }
@@ -35,18 +65,43 @@ void Clocktroller::Run() {
   is_running_ = true;
 }
 
+void Clocktroller::Kill() {
+  {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    is_dead_ = true;
+  }
+  run_condition_.notify_one();
+}
+
+void Clocktroller::WaitWhilePaused() {
+  std::unique_lock<std::mutex> lock(run_mutex_);
+  run_condition_.wait(lock, [this]() { return !is_paused_ || is_dead_; });
+}
+
 void Clocktroller::ExecutionLoop() {
+  scheduler::Scheduler* scheduler = memory_.scheduler();
+  MemoryMapper* memory_mapper = memory_.memory_mapper();
+  uint64_t last_flush = scheduler->now();
   for (;;) {
-    if (!is_paused_) {
-      if (is_dead_) {
-        return;
-      }
-      int ticks = opcode_executor_->ReadInstruction();
-      if (ticks < 0) {
-        is_dead_ = true;
-      } else {
-        memory_.Tick(ticks);
-      }
+    if (is_paused_) {
+      memory_mapper->Flush();
+      WaitWhilePaused();
+    }
+    if (is_dead_) {
+      memory_mapper->Flush();
+      return;
+    }
+    if (RunCPUSlice(opcode_executor_.get(), scheduler, kMaxSlice) < 0) {
+      is_dead_ = true;
+      continue;
+    }
+    scheduler->RunDueEvents();
+    SkipWhileHalted(opcode_executor_.get(), scheduler, kMaxSlice);
+    // Access records are published a batch at a time; make sure consumers
+    // are at most about a frame behind even when accesses are rare.
+    if (scheduler->now() - last_flush >= kMaxSlice) {
+      memory_mapper->Flush();
+      last_flush = scheduler->now();
     }
   }
 }
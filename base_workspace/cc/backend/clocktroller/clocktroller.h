@@ -1,39 +1,108 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_CLOCKTROLLER_CLOCKTROLLER_H_
 #define TURBO_SANTA_COMMON_BACK_END_CLOCKTROLLER_CLOCKTROLLER_H_
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <thread>
 
+#include "cc/backend/debug/instrumentation.h"
 #include "cc/backend/debug/master.h"
+#include "cc/backend/debug/memory_profiler/memory_profiler.h"
+#include "cc/backend/graphics/presenter.h"
 #include "cc/backend/memory/memory.h"
 #include "cc/backend/memory/memory_mapper.h"
 #include "cc/backend/opcode_executor/opcode_executor.h"
+#include "cc/backend/scheduler/scheduler.h"
 
 namespace backend {
 namespace clocktroller {
 
+// Bounds how many cycles a single call to RunCPUSlice or SkipWhileHalted may
+// cover, so that the ExecutionLoop gets back to noticing joypad input, a pause
+// or a kill, and to flushing access records, within about a frame. The PPU
+// always has an event scheduled, so in practice this only limits how long a
+// CPU halted with no enabled interrupt skips; one frame.
+const uint64_t kMaxSlice = 70224;
+
+// Runs the CPU until the next scheduled event is due, or for at most
+// max_cycles; the caller is responsible for running the due events. A halted
+// CPU with no enabled interrupt pending skips straight to the deadline.
+// Returns the number of instructions executed, or -1 if the CPU hit an error.
+long RunCPUSlice(opcode_executor::OpcodeExecutor* opcode_executor,
+                 scheduler::Scheduler* scheduler,
+                 uint64_t max_cycles);
+
+// While the CPU is halted with no enabled interrupt pending, runs scheduled
+// events back to back without it, for at most max_cycles, so that a HALT lasts
+// until an interrupt which IE enables is raised rather than until the next
+// event of any kind. Each time events are due run_due_events() is called to
+// run them, which lets a caller time them.
+template <typename RunDueEvents>
+void SkipWhileHalted(opcode_executor::OpcodeExecutor* opcode_executor,
+                     scheduler::Scheduler* scheduler,
+                     uint64_t max_cycles,
+                     RunDueEvents run_due_events) {
+  // Apart from the joypad, which is pressed from another thread and simply
+  // noticed here, interrupts are only requested by scheduled events, so
+  // nothing in between them can wake the CPU.
+  const uint64_t skip_end = scheduler->now() + max_cycles;
+  while (opcode_executor->halted() && !opcode_executor->interrupt_pending() &&
+         scheduler->now() < skip_end) {
+    scheduler->SkipTo(std::min(scheduler->next_deadline(), skip_end));
+    run_due_events();
+  }
+}
+
+inline void SkipWhileHalted(opcode_executor::OpcodeExecutor* opcode_executor,
+                            scheduler::Scheduler* scheduler,
+                            uint64_t max_cycles) {
+  SkipWhileHalted(opcode_executor, scheduler, max_cycles,
+                  [scheduler]() { scheduler->RunDueEvents(); });
+}
+
 class Clocktroller {
  public:
   Clocktroller(graphics::Screen* screen) : screen_(screen) {}
-  void Init(unsigned char* rom, long length);
+  void Init(std::shared_ptr<memory::ROMImage> rom);
   void Run();
   void Pause() { is_paused_ = true; }
-  void Kill() { is_dead_ = true; }
+  void Kill();
   void Wait() { thread_.join(); }
   memory::JoypadFlag* joypad_flag() { return memory_.joypad_flag(); }
+  // Draws frames on the presenter's thread instead of the emulation thread.
+  // Call after Init and before Run; the presenter must outlive the emulation.
+  void AttachPresenter(graphics::Presenter* presenter);
+  // The MemoryProfiler is always registered but is only sent memory accesses
+  // while profiling is on, so it can be attached to a running session.
+  void set_memory_profiling(bool enabled) {
+    debug::Instrumentation::set_enabled(debug::Instrumentation::MEMORY_READ, enabled);
+    debug::Instrumentation::set_enabled(debug::Instrumentation::MEMORY_WRITE, enabled);
+  }
+  // Available after Init.
+  debug::memory_profiler::MemoryProfiler* memory_profiler() { return memory_profiler_; }
 
  private:
-  debug::Master master_;
   memory::Memory memory_;
+  // Destroyed first, so that consumers have stopped before the memory mapper,
+  // which owns the record batches they hold, goes away.
+  debug::Master master_;
+  debug::memory_profiler::MemoryProfiler* memory_profiler_ = nullptr;
   graphics::Screen* screen_;
   std::unique_ptr<opcode_executor::OpcodeExecutor> opcode_executor_;
   bool is_running_ = false;
   std::atomic<bool> is_paused_;
   std::atomic<bool> is_dead_;
+  // The ExecutionLoop sleeps on run_condition_ while paused; Run() and Kill()
+  // change the flags under run_mutex_ so that a wake up cannot be missed.
+  std::mutex run_mutex_;
+  std::condition_variable run_condition_;
   std::thread thread_;
 
   void ExecutionLoop();
+  void WaitWhilePaused();
 };
 
 } // namespace clocktroller
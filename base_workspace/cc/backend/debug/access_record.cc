@@ -0,0 +1,27 @@
+#include "cc/backend/debug/access_record.h"
+
+namespace backend {
+namespace debug {
+
+using std::unique_ptr;
+
+RecordBatch* RecordPool::Acquire() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_batches_.empty()) {
+    batches_.push_back(unique_ptr<RecordBatch>(new RecordBatch()));
+    batches_.back()->pool_ = this;
+    return batches_.back().get();
+  }
+  RecordBatch* batch = free_batches_.back();
+  free_batches_.pop_back();
+  batch->size_ = 0;
+  return batch;
+}
+
+void RecordPool::Release(RecordBatch* batch) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_batches_.push_back(batch);
+}
+
+} // namespace debug
+} // namespace backend
@@ -0,0 +1,142 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_ACCESS_RECORD_H_
+#define TURBO_SANTA_COMMON_BACK_END_DEBUG_ACCESS_RECORD_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace backend {
+namespace debug {
+
+// A single memory access or executed instruction. Accesses are far too
+// frequent to be published as heap allocated Messages, so they are copied into
+// pooled batches instead.
+struct AccessRecord {
+  enum Mode : uint8_t {
+    READ,
+    WRITE,
+    INSTRUCTION,
+    MODE_NUMBER,
+  };
+
+  static AccessRecord Read(uint16_t address, uint8_t value, int16_t bank = 0, uint64_t cycle = 0) {
+    return {cycle, address, value, value, READ, bank};
+  }
+
+  static AccessRecord Write(uint16_t address, uint8_t old_value, uint8_t new_value, 
+                            int16_t bank = 0, uint64_t cycle = 0) {
+    return {cycle, address, old_value, new_value, WRITE, bank};
+  }
+
+  // The opcode is split between old_value, which holds the prefix (0xcb) if
+  // any, and new_value.
+  static AccessRecord Instruction(uint16_t address, uint16_t opcode, 
+                                  int16_t bank = 0, uint64_t cycle = 0) {
+    return {cycle, address, static_cast<uint8_t>(opcode >> 8), static_cast<uint8_t>(opcode), 
+            INSTRUCTION, bank};
+  }
+
+  uint16_t opcode() const { return (old_value << 8) | new_value; }
+
+  // The cycle on which the instruction making the access started.
+  uint64_t cycle;
+  // For an instruction, the address it was fetched from.
+  uint16_t address;
+  uint8_t old_value;
+  uint8_t new_value;
+  Mode mode;
+  // The bank mapped at address by the segment which owns it.
+  int16_t bank;
+};
+
+class RecordPool;
+
+// A fixed size block of records. Batches are filled by a single producer and
+// are read only once published.
+class RecordBatch {
+ public:
+  static const size_t kCapacity = 512;
+
+  void Append(const AccessRecord& record) { records_[size_++] = record; }
+
+  bool full() const { return size_ == kCapacity; }
+
+ private:
+  friend class RecordPool;
+  friend class RecordSpan;
+
+  AccessRecord records_[kCapacity];
+  size_t size_ = 0;
+  std::atomic<int> references_{0};
+  RecordPool* pool_ = nullptr;
+};
+
+// Hands out batches and takes them back once every RecordSpan referencing
+// them is gone. Batches are allocated on demand and then reused, so after
+// warming up publishing records does not allocate. Must outlive every
+// RecordSpan of its batches.
+class RecordPool {
+ public:
+  RecordPool() = default;
+  RecordPool(const RecordPool&) = delete;
+  RecordPool& operator=(const RecordPool&) = delete;
+
+  // Returns an empty batch.
+  RecordBatch* Acquire();
+
+  // Called from whichever thread drops the last reference.
+  void Release(RecordBatch* batch);
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<RecordBatch>> batches_;
+  std::vector<RecordBatch*> free_batches_;
+};
+
+// A read only view of a published batch, shared between every consumer it is
+// sent to. Copying a span only touches the batch's reference count.
+class RecordSpan {
+ public:
+  RecordSpan() = default;
+
+  explicit RecordSpan(RecordBatch* batch) : batch_(batch) { Reference(); }
+
+  RecordSpan(const RecordSpan& other) : batch_(other.batch_) { Reference(); }
+
+  RecordSpan(RecordSpan&& other) : batch_(other.batch_) { other.batch_ = nullptr; }
+
+  RecordSpan& operator=(RecordSpan other) {
+    std::swap(batch_, other.batch_);
+    return *this;
+  }
+
+  ~RecordSpan() {
+    if (batch_ != nullptr && batch_->references_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      batch_->pool_->Release(batch_);
+    }
+  }
+
+  const AccessRecord* begin() const { return batch_ == nullptr ? nullptr : batch_->records_; }
+
+  const AccessRecord* end() const { return begin() + size(); }
+
+  size_t size() const { return batch_ == nullptr ? 0 : batch_->size_; }
+
+ private:
+  void Reference() {
+    if (batch_ != nullptr) {
+      batch_->references_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  RecordBatch* batch_ = nullptr;
+};
+
+} // namespace debug
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_ACCESS_RECORD_H_
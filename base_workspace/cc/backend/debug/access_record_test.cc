@@ -0,0 +1,108 @@
+#include <vector>
+
+#include "cc/backend/debug/access_record.h"
+#include "cc/backend/debug/address_interest.h"
+#include "cc/backend/debug/publisher.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace debug {
+
+using std::vector;
+
+TEST(RecordPoolTest, ReusesBatchOnceLastSpanIsGone) {
+  RecordPool pool;
+  RecordBatch* batch = pool.Acquire();
+  batch->Append(AccessRecord::Write(0xc000, 0x01, 0x02));
+  {
+    RecordSpan span(batch);
+    RecordSpan copy = span;
+    ASSERT_EQ(1u, copy.size());
+    EXPECT_EQ(0xc000, copy.begin()->address);
+    EXPECT_EQ(AccessRecord::WRITE, copy.begin()->mode);
+    EXPECT_EQ(0x02, copy.begin()->new_value);
+    // Still referenced, so a new batch is allocated.
+    EXPECT_NE(batch, pool.Acquire());
+  }
+  RecordBatch* reused = pool.Acquire();
+  EXPECT_EQ(batch, reused);
+  RecordSpan empty(reused);
+  EXPECT_EQ(0u, empty.size());
+}
+
+class RecordingPublisher : public Publisher {
+ public:
+  void PublishRecords(RecordSpan records) override {
+    sizes.push_back(records.size());
+    for (const AccessRecord& record : records) {
+      addresses.push_back(record.address);
+    }
+  }
+
+  const AddressInterest* interest() const override { return &interest_; }
+
+  AddressInterest interest_;
+  vector<size_t> sizes;
+  vector<uint16_t> addresses;
+};
+
+TEST(PublisherTest, PublishesRecordsInBatches) {
+  RecordingPublisher sink;
+  sink.interest_.WatchAll(AddressInterest::READS);
+  Publisher publisher;
+  publisher.ForwardTo(&sink);
+  for (size_t i = 0; i < RecordBatch::kCapacity + 3; i++) {
+    publisher.PublishRecord(AccessRecord::Read(i, 0));
+  }
+  EXPECT_EQ(vector<size_t>({RecordBatch::kCapacity}), sink.sizes);
+
+  publisher.Flush();
+  EXPECT_EQ(vector<size_t>({RecordBatch::kCapacity, 3}), sink.sizes);
+
+  // Nothing is published for an empty batch.
+  publisher.Flush();
+  EXPECT_EQ(2u, sink.sizes.size());
+}
+
+TEST(PublisherTest, DropsRecordsNobodyIsInterestedIn) {
+  RecordingPublisher sink;
+  sink.interest_.Watch(0xff40, 0xff4b, AddressInterest::WRITES);
+  sink.interest_.Watch(0xc000, 0xc000, AddressInterest::READS_AND_WRITES);
+  Publisher publisher;
+  publisher.ForwardTo(&sink);
+  publisher.PublishRecord(AccessRecord::Write(0xff3f, 0, 1));
+  publisher.PublishRecord(AccessRecord::Write(0xff40, 0, 1));
+  publisher.PublishRecord(AccessRecord::Read(0xff40, 1));
+  publisher.PublishRecord(AccessRecord::Write(0xff4b, 0, 1));
+  publisher.PublishRecord(AccessRecord::Write(0xff4c, 0, 1));
+  publisher.PublishRecord(AccessRecord::Read(0xc000, 1));
+  publisher.PublishRecord(AccessRecord::Read(0xc001, 1));
+  publisher.Flush();
+  EXPECT_EQ(vector<uint16_t>({0xff40, 0xff4b, 0xc000}), sink.addresses);
+}
+
+TEST(PublisherTest, PublishesNothingWithoutAForwarder) {
+  Publisher publisher;
+  EXPECT_EQ(nullptr, publisher.interest());
+  publisher.PublishRecord(AccessRecord::Read(0xc000, 0));
+  publisher.Flush();
+}
+
+TEST(AddressInterestTest, MergesInterests) {
+  AddressInterest reads;
+  reads.Watch(0x8000, 0x9fff, AddressInterest::READS);
+  AddressInterest writes;
+  writes.Watch(0xffff, 0xffff, AddressInterest::WRITES);
+  AddressInterest merged;
+  merged.Merge(reads);
+  merged.Merge(writes);
+  EXPECT_TRUE(merged.Contains(AccessRecord::READ, 0x8000));
+  EXPECT_TRUE(merged.Contains(AccessRecord::READ, 0x9fff));
+  EXPECT_FALSE(merged.Contains(AccessRecord::WRITE, 0x9fff));
+  EXPECT_FALSE(merged.Contains(AccessRecord::READ, 0xa000));
+  EXPECT_TRUE(merged.Contains(AccessRecord::WRITE, 0xffff));
+  EXPECT_FALSE(merged.Contains(AccessRecord::READ, 0xffff));
+}
+
+} // namespace debug
+} // namespace backend
@@ -0,0 +1,63 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_ADDRESS_INTEREST_H_
+#define TURBO_SANTA_COMMON_BACK_END_DEBUG_ADDRESS_INTEREST_H_
+
+#include <cstdint>
+
+#include "cc/backend/debug/access_record.h"
+
+namespace backend {
+namespace debug {
+
+// The reads, writes and instructions a consumer wants to see, one bit per
+// address and mode. Publishers check the union of all consumers' interests
+// before recording an access, so accesses nobody watches are never copied or
+// queued.
+class AddressInterest {
+ public:
+  enum Modes {
+    READS = 1 << AccessRecord::READ,
+    WRITES = 1 << AccessRecord::WRITE,
+    READS_AND_WRITES = READS | WRITES,
+    INSTRUCTIONS = 1 << AccessRecord::INSTRUCTION,
+  };
+
+  // Adds every address from first to last, inclusive.
+  void Watch(uint16_t first, uint16_t last, int modes) {
+    for (uint32_t address = first; address <= last; address++) {
+      for (int mode = 0; mode < AccessRecord::MODE_NUMBER; mode++) {
+        if (modes & (1 << mode)) {
+          bits_[mode][address >> 6] |= uint64_t(1) << (address & 63);
+        }
+      }
+    }
+  }
+
+  void WatchAll(int modes) { Watch(0x0000, 0xffff, modes); }
+
+  // Adds everything other is interested in.
+  void Merge(const AddressInterest& other) {
+    for (int mode = 0; mode < AccessRecord::MODE_NUMBER; mode++) {
+      for (int word = 0; word < kWords; word++) {
+        bits_[mode][word] |= other.bits_[mode][word];
+      }
+    }
+  }
+
+  bool Contains(AccessRecord::Mode mode, uint16_t address) const {
+    return (bits_[mode][address >> 6] >> (address & 63)) & 1;
+  }
+
+  bool Contains(const AccessRecord& record) const {
+    return Contains(record.mode, record.address);
+  }
+
+ private:
+  static const int kWords = 0x10000 / 64;
+
+  uint64_t bits_[AccessRecord::MODE_NUMBER][kWords] = {};
+};
+
+} // namespace debug
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_ADDRESS_INTEREST_H_
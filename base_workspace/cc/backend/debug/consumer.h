@@ -8,6 +8,7 @@ namespace debug {
 
 class Consumer {
  public:
+  virtual ~Consumer() = default;
   virtual FilterBase* filter_external() = 0;
   virtual void Run() = 0;
 };
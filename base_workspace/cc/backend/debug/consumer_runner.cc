@@ -3,8 +3,18 @@
 namespace backend {
 namespace debug {
 
+ConsumerRunner::~ConsumerRunner() {
+  if (thread_.joinable()) {
+    consumer_->filter_external()->Close();
+    thread_.join();
+  }
+}
+
 void ConsumerRunner::Exec() {
-  thread_ = std::thread([this]() { this->consumer_->Run(); });
+  // Runners are moved around by Master, so the thread must not hold on to
+  // this.
+  Consumer* consumer = consumer_.get();
+  thread_ = std::thread([consumer]() { consumer->Run(); });
 }
 
 } // namespace debug
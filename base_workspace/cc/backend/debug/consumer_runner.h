@@ -14,6 +14,11 @@ class ConsumerRunner {
   ConsumerRunner(std::unique_ptr<Consumer> consumer) 
       : consumer_(std::move(consumer)) {}
 
+  ConsumerRunner(ConsumerRunner&&) = default;
+
+  // Closes the consumer's filter and waits for it to finish.
+  ~ConsumerRunner();
+
   void Exec();
 
   FilterBase* filter() { return consumer_->filter_external(); }
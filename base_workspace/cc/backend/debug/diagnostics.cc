@@ -0,0 +1,213 @@
+#include "cc/backend/debug/diagnostics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace backend {
+namespace debug {
+
+using std::string;
+using std::vector;
+
+std::atomic<bool> Diagnostics::enabled_[SUBSYSTEM_NUMBER];
+const int Diagnostics::kEntryNumber;
+const int Diagnostics::kMaxArguments;
+
+namespace {
+
+struct Entry {
+  const char* format;
+  uint64_t time; // Steady clock ticks.
+  uint64_t args[Diagnostics::kMaxArguments];
+  uint8_t subsystem;
+  uint8_t arg_count;
+};
+
+// Written only by the thread which owns it. written counts every entry ever
+// recorded, so entry i lives at i % kEntryNumber until it is overwritten.
+struct ThreadBuffer {
+  int thread_number;
+  std::atomic<uint64_t> written{0};
+  std::atomic<uint64_t> cleared{0};
+  Entry entries[Diagnostics::kEntryNumber];
+};
+
+// Buffers outlive their threads so that Dump can still show what a thread
+// did before it exited. The registry is never destroyed, since threads may
+// still be recording while static destructors run.
+struct Registry {
+  std::mutex lock;
+  vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry* GetRegistry() {
+  static Registry* registry = new Registry();
+  return registry;
+}
+
+thread_local ThreadBuffer* thread_buffer = nullptr;
+
+ThreadBuffer* GetThreadBuffer() {
+  if (thread_buffer == nullptr) {
+    Registry* registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry->lock);
+    registry->buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+    thread_buffer = registry->buffers.back().get();
+    thread_buffer->thread_number = registry->buffers.size() - 1;
+  }
+  return thread_buffer;
+}
+
+void Append(Diagnostics::Subsystem subsystem, const char* format, int arg_count,
+            uint64_t arg0, uint64_t arg1, uint64_t arg2, uint64_t arg3) {
+  ThreadBuffer* buffer = GetThreadBuffer();
+  const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+  Entry& entry = buffer->entries[index % Diagnostics::kEntryNumber];
+  entry.format = format;
+  entry.time = std::chrono::steady_clock::now().time_since_epoch().count();
+  entry.args[0] = arg0;
+  entry.args[1] = arg1;
+  entry.args[2] = arg2;
+  entry.args[3] = arg3;
+  entry.subsystem = subsystem;
+  entry.arg_count = arg_count;
+  buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void Format(const Entry& entry, std::ostream* out) {
+  int arg = 0;
+  for (const char* c = entry.format; *c != '\0'; c++) {
+    if (*c != '%' || c[1] == '\0') {
+      *out << *c;
+      continue;
+    }
+    c++;
+    if (*c == '%') {
+      *out << '%';
+    } else if (arg >= entry.arg_count) {
+      *out << '?';
+    } else if (*c == 'x') {
+      *out << std::hex << entry.args[arg++] << std::dec;
+    } else {
+      *out << entry.args[arg++];
+    }
+  }
+}
+
+struct DumpedEntry {
+  Entry entry;
+  int thread_number;
+};
+
+} // namespace
+
+bool Diagnostics::EnableByName(const string& names) {
+  std::istringstream stream(names);
+  string name;
+  bool recognized = true;
+  while (std::getline(stream, name, ',')) {
+    bool found = false;
+    for (int i = 0; i < SUBSYSTEM_NUMBER; i++) {
+      Subsystem subsystem = static_cast<Subsystem>(i);
+      if (name == "all" || name == Name(subsystem)) {
+        set_enabled(subsystem, true);
+        found = true;
+      }
+    }
+    recognized = recognized && found;
+  }
+  return recognized;
+}
+
+const char* Diagnostics::Name(Subsystem subsystem) {
+  switch (subsystem) {
+    case CPU:
+      return "cpu";
+    case INTERRUPTS:
+      return "interrupts";
+    case GRAPHICS:
+      return "graphics";
+    case VRAM:
+      return "vram";
+    case JOYPAD:
+      return "joypad";
+    default:
+      return "unknown";
+  }
+}
+
+void Diagnostics::Record(Subsystem subsystem, const char* format) {
+  Append(subsystem, format, 0, 0, 0, 0, 0);
+}
+
+void Diagnostics::Record(Subsystem subsystem, const char* format, uint64_t arg0) {
+  Append(subsystem, format, 1, arg0, 0, 0, 0);
+}
+
+void Diagnostics::Record(Subsystem subsystem, const char* format, uint64_t arg0, uint64_t arg1) {
+  Append(subsystem, format, 2, arg0, arg1, 0, 0);
+}
+
+void Diagnostics::Record(Subsystem subsystem, const char* format, uint64_t arg0, uint64_t arg1,
+                         uint64_t arg2) {
+  Append(subsystem, format, 3, arg0, arg1, arg2, 0);
+}
+
+void Diagnostics::Record(Subsystem subsystem, const char* format, uint64_t arg0, uint64_t arg1,
+                         uint64_t arg2, uint64_t arg3) {
+  Append(subsystem, format, 4, arg0, arg1, arg2, arg3);
+}
+
+void Diagnostics::Dump(std::ostream* out) {
+  const uint64_t capacity = kEntryNumber;
+  vector<DumpedEntry> dumped;
+  Registry* registry = GetRegistry();
+  {
+    std::lock_guard<std::mutex> guard(registry->lock);
+    for (const auto& buffer : registry->buffers) {
+      const uint64_t end = buffer->written.load(std::memory_order_acquire);
+      uint64_t begin = end > capacity ? end - capacity : 0;
+      begin = std::max(begin, buffer->cleared.load(std::memory_order_relaxed));
+      const size_t first = dumped.size();
+      for (uint64_t i = begin; i < end; i++) {
+        dumped.push_back({buffer->entries[i % kEntryNumber], buffer->thread_number});
+      }
+      // Entries the thread overwrote, or may have been overwriting, while they
+      // were being copied are torn.
+      const uint64_t reused = buffer->written.load(std::memory_order_acquire) + 1;
+      if (reused - begin > capacity) {
+        const uint64_t torn = std::min(reused - begin - capacity, end - begin);
+        dumped.erase(dumped.begin() + first, dumped.begin() + first + torn);
+      }
+    }
+  }
+  std::stable_sort(dumped.begin(), dumped.end(), [](const DumpedEntry& a, const DumpedEntry& b) {
+    return a.entry.time < b.entry.time;
+  });
+
+  const uint64_t start = dumped.empty() ? 0 : dumped.front().entry.time;
+  for (const DumpedEntry& dumped_entry : dumped) {
+    const auto since_start = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::duration(dumped_entry.entry.time - start));
+    *out << since_start.count() << "us [thread " << dumped_entry.thread_number << "] "
+         << Name(static_cast<Subsystem>(dumped_entry.entry.subsystem)) << ": ";
+    Format(dumped_entry.entry, out);
+    *out << "\n";
+  }
+}
+
+void Diagnostics::Clear() {
+  Registry* registry = GetRegistry();
+  std::lock_guard<std::mutex> guard(registry->lock);
+  for (const auto& buffer : registry->buffers) {
+    buffer->cleared.store(buffer->written.load(std::memory_order_acquire),
+                          std::memory_order_relaxed);
+  }
+}
+
+} // namespace debug
+} // namespace backend
@@ -0,0 +1,91 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_DIAGNOSTICS_H_
+#define TURBO_SANTA_COMMON_BACK_END_DEBUG_DIAGNOSTICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// How much diagnostics code is compiled in: 0 for none, 1 for occasional
+// events (interrupts, frames, register writes), 2 for events which happen on
+// every instruction or memory access as well. Anything above the compiled
+// level is removed entirely, arguments included.
+#ifndef TURBO_SANTA_DIAGNOSTICS_LEVEL
+#define TURBO_SANTA_DIAGNOSTICS_LEVEL 0
+#endif
+
+namespace backend {
+namespace debug {
+
+// A cheap replacement for LOG(INFO) in code which runs too often for glog.
+// DIAGNOSE does not format anything: it copies the format string's address
+// and up to four integer arguments into a ring buffer owned by the calling
+// thread, without locking. The entries are only formatted when Dump is called,
+// for example after the emulator stops or crashes.
+//
+// Every subsystem is off by default; a subsystem which is off costs one
+// relaxed load and a branch.
+class Diagnostics {
+ public:
+  enum Subsystem {
+    CPU,
+    INTERRUPTS,
+    GRAPHICS,
+    VRAM,
+    JOYPAD,
+    SUBSYSTEM_NUMBER,
+  };
+
+  // The number of entries kept for each thread; older ones are overwritten.
+  static const int kEntryNumber = 4096;
+  static const int kMaxArguments = 4;
+
+  static bool enabled(Subsystem subsystem) {
+    return enabled_[subsystem].load(std::memory_order_relaxed);
+  }
+
+  static void set_enabled(Subsystem subsystem, bool enabled) {
+    enabled_[subsystem].store(enabled, std::memory_order_relaxed);
+  }
+
+  // Enables the subsystems named in a comma separated list, such as
+  // "cpu,interrupts", or all of them for "all". Returns false if a name is
+  // not recognized.
+  static bool EnableByName(const std::string& names);
+
+  static const char* Name(Subsystem subsystem);
+
+  // format may only contain %d (decimal), %x (hex) and %%, and must outlive
+  // every call to Dump; in practice it is always a string literal.
+  static void Record(Subsystem subsystem, const char* format);
+  static void Record(Subsystem subsystem, const char* format, uint64_t arg0);
+  static void Record(Subsystem subsystem, const char* format, uint64_t arg0, uint64_t arg1);
+  static void Record(Subsystem subsystem, const char* format, uint64_t arg0, uint64_t arg1,
+                     uint64_t arg2);
+  static void Record(Subsystem subsystem, const char* format, uint64_t arg0, uint64_t arg1,
+                     uint64_t arg2, uint64_t arg3);
+
+  // Formats the entries of every thread, oldest first, one per line. Meant
+  // for when the recording threads are stopped; entries overwritten while
+  // Dump runs are skipped.
+  static void Dump(std::ostream* out);
+
+  // Forgets every entry recorded so far.
+  static void Clear();
+
+ private:
+  static std::atomic<bool> enabled_[SUBSYSTEM_NUMBER];
+};
+
+} // namespace debug
+} // namespace backend
+
+#define DIAGNOSE(level, subsystem, ...) \
+  do { \
+    if ((level) <= TURBO_SANTA_DIAGNOSTICS_LEVEL && \
+        backend::debug::Diagnostics::enabled(backend::debug::Diagnostics::subsystem)) { \
+      backend::debug::Diagnostics::Record(backend::debug::Diagnostics::subsystem, __VA_ARGS__); \
+    } \
+  } while (0)
+
+#endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_DIAGNOSTICS_H_
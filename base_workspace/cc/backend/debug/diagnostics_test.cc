@@ -0,0 +1,60 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "cc/backend/debug/diagnostics.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace debug {
+
+using std::string;
+
+class DiagnosticsTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Diagnostics::Clear(); }
+
+  void TearDown() override {
+    for (int i = 0; i < Diagnostics::SUBSYSTEM_NUMBER; i++) {
+      Diagnostics::set_enabled(static_cast<Diagnostics::Subsystem>(i), false);
+    }
+    Diagnostics::Clear();
+  }
+
+  string Dump() {
+    std::ostringstream out;
+    Diagnostics::Dump(&out);
+    return out.str();
+  }
+};
+
+TEST_F(DiagnosticsTest, FormatsOnlyEnabledSubsystems) {
+  Diagnostics::set_enabled(Diagnostics::CPU, true);
+  DIAGNOSE(2, CPU, "Executing 0x%x at 0x%x, %d%%", 0xcb, 0x150, 50);
+  DIAGNOSE(1, INTERRUPTS, "Not recorded.");
+
+  string dump = Dump();
+  EXPECT_NE(string::npos, dump.find("cpu: Executing 0xcb at 0x150, 50%")) << dump;
+  EXPECT_EQ(string::npos, dump.find("Not recorded")) << dump;
+}
+
+TEST_F(DiagnosticsTest, KeepsTheNewestEntriesOfEachThread) {
+  ASSERT_TRUE(Diagnostics::EnableByName("vram,joypad"));
+  EXPECT_FALSE(Diagnostics::EnableByName("sound"));
+  std::thread other([]() { DIAGNOSE(1, JOYPAD, "From another thread."); });
+  other.join();
+  for (int i = 0; i < Diagnostics::kEntryNumber + 10; i++) {
+    DIAGNOSE(2, VRAM, "Write %d", i);
+  }
+
+  string dump = Dump();
+  EXPECT_NE(string::npos, dump.find("joypad: From another thread.")) << dump;
+  // The oldest entry is skipped as well, since a thread could have been
+  // overwriting it during the dump.
+  EXPECT_EQ(string::npos, dump.find("Write 9\n"));
+  EXPECT_NE(string::npos, dump.find("Write 11\n"));
+  EXPECT_NE(string::npos, dump.find("Write 4105\n"));
+}
+
+} // namespace debug
+} // namespace backend
@@ -3,9 +3,11 @@
 
 #include <memory>
 
+#include "cc/backend/debug/access_record.h"
+#include "cc/backend/debug/address_interest.h"
 #include "cc/backend/debug/message.h"
 #include "cc/utility/option.h"
-#include "cc/utility/stream.h"
+#include "cc/utility/ring_buffer.h"
 
 namespace backend {
 namespace debug {
@@ -15,6 +17,16 @@ namespace debug {
 class FilterBase {
  public:
   virtual void PutMessage(std::shared_ptr<const Message> message) = 0;
+
+  // Only filters which want access records need to override this.
+  virtual void PutRecords(RecordSpan) {}
+
+  // The accesses this filter wants, or nullptr for none. Read when the
+  // consumer is registered.
+  virtual const AddressInterest* interest() const { return nullptr; }
+
+  // Stops the owning consumer once it has taken what is already queued.
+  virtual void Close() = 0;
 };
 
 
@@ -27,6 +39,16 @@ class FilterBase {
 template <typename T>
 class Filter : public FilterBase {
  public:
+  typedef utility::RingBuffer<std::shared_ptr<const Message>> MessageBuffer;
+
+  static const size_t kDefaultCapacity = 1 << 16;
+
+  // Messages are queued until the consumer takes them; once capacity are
+  // waiting, policy decides whether the publisher waits or messages are lost.
+  Filter(size_t capacity = kDefaultCapacity, 
+         typename MessageBuffer::OverflowPolicy policy = MessageBuffer::BLOCK) :
+      in_stream_(capacity, policy) {}
+
   // Apply should only limit the amount of data received not create new data in
   // any way. The result of Apply will be wrapped in a shared pointer that
   // references the message pointed into this and will NOT be destroyed until
@@ -61,10 +83,54 @@ class Filter : public FilterBase {
 
   bool is_closed() { return in_stream_.is_closed(); }
 
-  void Close() { in_stream_.Close(); }
+  void Close() override { in_stream_.Close(); }
+
+  // The number of messages lost because the consumer fell behind.
+  uint64_t dropped() const { return in_stream_.dropped(); }
+
+ private:
+  MessageBuffer in_stream_;
+};
+
+// Receives memory accesses as batches of access records, rather than as one
+// message each, and ignores all other messages. Only accesses added to
+// mutable_interest() before the consumer is registered are published, but
+// batches are shared by every consumer, so they may also hold accesses
+// another consumer asked for; check them against interest().
+class RecordFilter : public FilterBase {
+ public:
+  typedef utility::RingBuffer<RecordSpan> RecordBuffer;
+
+  // Counted in batches, not records.
+  static const size_t kDefaultCapacity = 256;
+
+  RecordFilter(size_t capacity = kDefaultCapacity,
+               RecordBuffer::OverflowPolicy policy = RecordBuffer::BLOCK) :
+      in_stream_(capacity, policy) {}
+
+  void PutMessage(std::shared_ptr<const Message>) override final {}
+
+  void PutRecords(RecordSpan records) override final {
+    in_stream_.Put(std::move(records));
+  }
+
+  const AddressInterest* interest() const override { return &interest_; }
+
+  AddressInterest* mutable_interest() { return &interest_; }
+
+  // The records stay valid for as long as the returned span is held.
+  utility::Option<RecordSpan> TakeRecords() { return in_stream_.Take(); }
+
+  bool is_closed() { return in_stream_.is_closed(); }
+
+  void Close() override { in_stream_.Close(); }
+
+  // The number of batches lost because the consumer fell behind.
+  uint64_t dropped() const { return in_stream_.dropped(); }
 
  private:
-  utility::Stream<std::shared_ptr<const Message>> in_stream_;
+  RecordBuffer in_stream_;
+  AddressInterest interest_;
 };
 
 } // namespace debug
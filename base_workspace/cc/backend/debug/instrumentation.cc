@@ -0,0 +1,9 @@
+#include "cc/backend/debug/instrumentation.h"
+
+namespace backend {
+namespace debug {
+
+std::atomic<bool> Instrumentation::enabled_[CATEGORY_NUMBER];
+
+} // namespace debug
+} // namespace backend
@@ -0,0 +1,38 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_INSTRUMENTATION_H_
+#define TURBO_SANTA_COMMON_BACK_END_DEBUG_INSTRUMENTATION_H_
+
+#include <atomic>
+
+namespace backend {
+namespace debug {
+
+// Which categories of message are published. Everything is off by default;
+// PUBLISH checks the category before building the message, so a category
+// which is off costs one relaxed load and a branch.
+class Instrumentation {
+ public:
+  enum Category {
+    MEMORY_READ,
+    MEMORY_WRITE,
+    GRAPHICS,
+    OPCODE_EXECUTOR,
+    UNSTRUCTURED,
+    CATEGORY_NUMBER,
+  };
+
+  static bool enabled(Category category) {
+    return enabled_[category].load(std::memory_order_relaxed);
+  }
+
+  static void set_enabled(Category category, bool enabled) {
+    enabled_[category].store(enabled, std::memory_order_relaxed);
+  }
+
+ private:
+  static std::atomic<bool> enabled_[CATEGORY_NUMBER];
+};
+
+} // namespace debug
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_INSTRUMENTATION_H_
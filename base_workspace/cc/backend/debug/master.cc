@@ -15,6 +15,10 @@ void Master::SendToConsumers(unique_ptr<Message> message) {
 }
 
 void Master::Register(unique_ptr<Consumer> consumer) {
+  const AddressInterest* interest = consumer->filter_external()->interest();
+  if (interest != nullptr) {
+    interest_.Merge(*interest);
+  }
   // Consumers are not copyable.
   consumers_.emplace_back(std::move(consumer));
   auto end = consumers_.end();
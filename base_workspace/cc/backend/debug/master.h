@@ -15,16 +15,29 @@ class Master : public Publisher {
  public:
   void SendToConsumers(std::unique_ptr<Message> message);
 
-  // NOT THREAD SAFE!
+  // NOT THREAD SAFE! Adds the consumer's address interest to interest(), so
+  // consumers should be registered before any access is published.
   void Register(std::unique_ptr<Consumer> consumer);
 
   void Publish(std::unique_ptr<Message> message) override {
     SendToConsumers(std::move(message)); 
   }
 
+  // Every consumer shares the same batch.
+  void PublishRecords(RecordSpan records) override {
+    for (ConsumerRunner& consumer : consumers_) {
+      consumer.filter()->PutRecords(records);
+    }
+  }
+
   void ForwardTo(Publisher*) override {};
+
+  // The union of every registered consumer's interest.
+  const AddressInterest* interest() const override { return &interest_; }
+
  private:
   std::vector<ConsumerRunner> consumers_;
+  AddressInterest interest_;
 };
 
 } // namespace debug
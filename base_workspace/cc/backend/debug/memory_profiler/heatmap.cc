@@ -0,0 +1,106 @@
+#include "cc/backend/debug/memory_profiler/heatmap.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace backend {
+namespace debug {
+namespace memory_profiler {
+
+using std::ostream;
+using std::vector;
+
+namespace {
+
+void WriteLittleEndian(ostream* out, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    out->put(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+} // namespace
+
+const int Heatmap::kBankNumber;
+const uint32_t Heatmap::kBinaryVersion;
+
+const vector<Heatmap::Region>& Heatmap::Regions() {
+  static const vector<Region> regions = {
+    {"ROM0", 0x0000, 0x3fff},
+    {"ROMX", 0x4000, 0x7fff},
+    {"VRAM", 0x8000, 0x9fff},
+    {"SRAM", 0xa000, 0xbfff},
+    {"WRAM", 0xc000, 0xdfff},
+    {"ECHO", 0xe000, 0xfdff},
+    {"OAM", 0xfe00, 0xfe9f},
+    {"UNUSABLE", 0xfea0, 0xfeff},
+    {"IO", 0xff00, 0xff7f},
+    {"HRAM", 0xff80, 0xfffe},
+    {"IE", 0xffff, 0xffff},
+  };
+  return regions;
+}
+
+uint64_t Heatmap::region_reads(const Region& region) const {
+  uint64_t total = 0;
+  for (uint32_t address = region.first; address <= region.last; address++) {
+    total += reads_[address];
+  }
+  return total;
+}
+
+uint64_t Heatmap::region_writes(const Region& region) const {
+  uint64_t total = 0;
+  for (uint32_t address = region.first; address <= region.last; address++) {
+    total += writes_[address];
+  }
+  return total;
+}
+
+void Heatmap::Clear() {
+  std::fill(reads_, reads_ + kAddressNumber, 0);
+  std::fill(writes_, writes_ + kAddressNumber, 0);
+  std::fill(bank_reads_, bank_reads_ + kBankNumber, 0);
+  std::fill(bank_writes_, bank_writes_ + kBankNumber, 0);
+}
+
+void Heatmap::WriteCSV(ostream* out) const {
+  *out << "scope,name,reads,writes\n";
+  for (const Region& region : Regions()) {
+    *out << "region," << region.name << ","
+        << region_reads(region) << "," << region_writes(region) << "\n";
+  }
+  for (int bank = -1; bank < kBankNumber - 1; bank++) {
+    if (bank_reads(bank) != 0 || bank_writes(bank) != 0) {
+      *out << "bank," << std::dec << bank << ","
+          << bank_reads(bank) << "," << bank_writes(bank) << "\n";
+    }
+  }
+  for (int address = 0; address < kAddressNumber; address++) {
+    if (reads_[address] != 0 || writes_[address] != 0) {
+      *out << "address,0x" << std::hex << std::setw(4) << std::setfill('0') << address
+          << std::dec << "," << reads_[address] << "," << writes_[address] << "\n";
+    }
+  }
+}
+
+void Heatmap::WriteBinary(ostream* out) const {
+  out->write("TSHM", 4);
+  WriteLittleEndian(out, kBinaryVersion, 4);
+  WriteLittleEndian(out, kBankNumber, 4);
+  for (uint64_t count : reads_) {
+    WriteLittleEndian(out, count, 8);
+  }
+  for (uint64_t count : writes_) {
+    WriteLittleEndian(out, count, 8);
+  }
+  for (uint64_t count : bank_reads_) {
+    WriteLittleEndian(out, count, 8);
+  }
+  for (uint64_t count : bank_writes_) {
+    WriteLittleEndian(out, count, 8);
+  }
+}
+
+} // namespace memory_profiler
+} // namespace debug
+} // namespace backend
@@ -0,0 +1,84 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_MEMORY_PROFILER_HEATMAP_H_
+#define TURBO_SANTA_COMMON_BACK_END_DEBUG_MEMORY_PROFILER_HEATMAP_H_
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "cc/backend/debug/access_record.h"
+
+namespace backend {
+namespace debug {
+namespace memory_profiler {
+
+// Counts reads and writes to every address, and to every ROM bank, in flat
+// arrays so that adding an access is a couple of increments. Region totals
+// are only summed up when a snapshot is written.
+class Heatmap {
+ public:
+  struct Region {
+    const char* name;
+    uint16_t first;
+    uint16_t last; // Inclusive.
+  };
+
+  // The regions of the address space, in order.
+  static const std::vector<Region>& Regions();
+
+  // Banks are counted from the internal ROM, reported as bank -1, up.
+  static const int kBankNumber = 257;
+
+  // Instructions are ignored.
+  void Add(const AccessRecord& record) {
+    if (record.mode == AccessRecord::READ) {
+      reads_[record.address]++;
+    } else if (record.mode == AccessRecord::WRITE) {
+      writes_[record.address]++;
+    } else {
+      return;
+    }
+    if (record.address < kROMEnd && record.bank >= -1 && record.bank < kBankNumber - 1) {
+      if (record.mode == AccessRecord::READ) {
+        bank_reads_[record.bank + 1]++;
+      } else {
+        bank_writes_[record.bank + 1]++;
+      }
+    }
+  }
+
+  uint64_t reads(uint16_t address) const { return reads_[address]; }
+  uint64_t writes(uint16_t address) const { return writes_[address]; }
+  uint64_t region_reads(const Region& region) const;
+  uint64_t region_writes(const Region& region) const;
+  uint64_t bank_reads(int bank) const { return bank_reads_[bank + 1]; }
+  uint64_t bank_writes(int bank) const { return bank_writes_[bank + 1]; }
+
+  void Clear();
+
+  // One line per region, per ROM bank and per address that has been
+  // accessed, each giving its reads and writes:
+  //   scope,name,reads,writes
+  void WriteCSV(std::ostream* out) const;
+
+  // The magic "TSHM", a version and the number of banks as little endian
+  // 32-bit values, followed by the read counts then write counts of every
+  // address and then of every bank, as little endian 64-bit values.
+  void WriteBinary(std::ostream* out) const;
+
+  static const uint32_t kBinaryVersion = 1;
+
+ private:
+  static const int kAddressNumber = 0x10000;
+  static const uint16_t kROMEnd = 0x8000;
+
+  uint64_t reads_[kAddressNumber] = {};
+  uint64_t writes_[kAddressNumber] = {};
+  uint64_t bank_reads_[kBankNumber] = {};
+  uint64_t bank_writes_[kBankNumber] = {};
+};
+
+} // namespace memory_profiler
+} // namespace debug
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_MEMORY_PROFILER_HEATMAP_H_
@@ -0,0 +1,92 @@
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "cc/backend/debug/memory_profiler/heatmap.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace debug {
+namespace memory_profiler {
+
+using std::string;
+using std::unique_ptr;
+
+namespace {
+
+const Heatmap::Region& FindRegion(const string& name) {
+  for (const Heatmap::Region& region : Heatmap::Regions()) {
+    if (name == region.name) {
+      return region;
+    }
+  }
+  return Heatmap::Regions().front();
+}
+
+} // namespace
+
+TEST(HeatmapTest, CountsAddressesRegionsAndBanks) {
+  unique_ptr<Heatmap> heatmap(new Heatmap());
+  heatmap->Add(AccessRecord::Read(0x4100, 0x00, 3));
+  heatmap->Add(AccessRecord::Read(0x4100, 0x00, 3));
+  heatmap->Add(AccessRecord::Read(0x0050, 0x00, -1));
+  heatmap->Add(AccessRecord::Write(0x8000, 0x00, 0xff));
+  heatmap->Add(AccessRecord::Write(0x9fff, 0x00, 0xff));
+  heatmap->Add(AccessRecord::Read(0xff44, 0x90));
+
+  EXPECT_EQ(2u, heatmap->reads(0x4100));
+  EXPECT_EQ(0u, heatmap->writes(0x4100));
+  EXPECT_EQ(2u, heatmap->bank_reads(3));
+  EXPECT_EQ(1u, heatmap->bank_reads(-1));
+  EXPECT_EQ(2u, heatmap->region_writes(FindRegion("VRAM")));
+  EXPECT_EQ(0u, heatmap->region_reads(FindRegion("VRAM")));
+  EXPECT_EQ(1u, heatmap->region_reads(FindRegion("IO")));
+
+  heatmap->Clear();
+  EXPECT_EQ(0u, heatmap->reads(0x4100));
+  EXPECT_EQ(0u, heatmap->bank_reads(3));
+}
+
+TEST(HeatmapTest, RegionsCoverTheAddressSpace) {
+  uint32_t next = 0;
+  for (const Heatmap::Region& region : Heatmap::Regions()) {
+    EXPECT_EQ(next, region.first) << region.name;
+    next = region.last + 1u;
+  }
+  EXPECT_EQ(0x10000u, next);
+}
+
+TEST(HeatmapTest, WritesCSV) {
+  unique_ptr<Heatmap> heatmap(new Heatmap());
+  heatmap->Add(AccessRecord::Read(0x4100, 0x00, 1));
+  heatmap->Add(AccessRecord::Write(0xc00a, 0x00, 0x01));
+  std::ostringstream out;
+  heatmap->WriteCSV(&out);
+  const string csv = out.str();
+  EXPECT_EQ(0u, csv.find("scope,name,reads,writes\n"));
+  EXPECT_NE(string::npos, csv.find("region,ROMX,1,0\n"));
+  EXPECT_NE(string::npos, csv.find("region,WRAM,0,1\n"));
+  EXPECT_NE(string::npos, csv.find("bank,1,1,0\n"));
+  EXPECT_NE(string::npos, csv.find("address,0x4100,1,0\n"));
+  EXPECT_NE(string::npos, csv.find("address,0xc00a,0,1\n"));
+  EXPECT_EQ(string::npos, csv.find("address,0xc00b"));
+}
+
+TEST(HeatmapTest, WritesBinary) {
+  unique_ptr<Heatmap> heatmap(new Heatmap());
+  heatmap->Add(AccessRecord::Write(0x0001, 0x00, 0x01));
+  std::ostringstream out;
+  heatmap->WriteBinary(&out);
+  const string binary = out.str();
+  ASSERT_EQ(12u + 8u * (2 * 0x10000 + 2 * Heatmap::kBankNumber), binary.size());
+  EXPECT_EQ("TSHM", binary.substr(0, 4));
+  EXPECT_EQ(Heatmap::kBinaryVersion, static_cast<uint8_t>(binary[4]));
+  // The write count of address 1, after all of the read counts.
+  const size_t offset = 12 + 8 * (0x10000 + 1);
+  EXPECT_EQ(1, binary[offset]);
+  EXPECT_EQ(0, binary[offset + 1]);
+}
+
+} // namespace memory_profiler
+} // namespace debug
+} // namespace backend
@@ -1,8 +1,9 @@
 #include "cc/backend/debug/memory_profiler/memory_profiler.h"
 
-#include <memory>
+#include <cstdio>
+#include <fstream>
 
-#include "cc/backend/debug/memory_profiler/memory_access.h"
+#include "cc/backend/debug/access_record.h"
 #include "cc/utility/option.h"
 #include "glog/logging.h"
 
@@ -10,35 +11,68 @@ namespace backend {
 namespace debug {
 namespace memory_profiler {
 
-using std::shared_ptr;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+using std::string;
 using utility::Option;
 
-namespace {
-
-void HandleMessage(shared_ptr<const MemoryAccess> memory_access) {
-  if (memory_access->READ) {
-    LOG(INFO) << "Read performed at: " << memory_access->address() 
-        << ", value = " << memory_access->old_value();
-  } else {
-    LOG(INFO) << "Write performed at: " << memory_access->address() 
-        << ", old value = " << memory_access->old_value()
-        << ", new value = " << memory_access->new_value();
+void MemoryProfiler::Run() {
+  LOG(INFO) << "Running..";
+  while (!filter_.is_closed()) {
+    Option<RecordSpan> records = filter_.TakeRecords();
+    if (!records.is_present()) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const AccessRecord& record : records.get()) {
+      heatmap_.Add(record);
+    }
+    if (snapshot_interval_.count() > 0 && 
+        steady_clock::now() - last_snapshot_ >= snapshot_interval_) {
+      WriteSnapshotLocked(snapshot_path_, snapshot_format_);
+      last_snapshot_ = steady_clock::now();
+    }
   }
 }
 
-} // namespace
+bool MemoryProfiler::WriteSnapshot(const string& path, Format format) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return WriteSnapshotLocked(path, format);
+}
+
+void MemoryProfiler::set_snapshot_interval(milliseconds interval, 
+                                           const string& path,
+                                           Format format) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  snapshot_interval_ = interval;
+  snapshot_path_ = path;
+  snapshot_format_ = format;
+  last_snapshot_ = steady_clock::now();
+}
 
-void MemoryProfiler::Run() {
-  LOG(INFO) << "Running..";
-  while (!filter_.is_closed()) {
-    Option<shared_ptr<const MemoryAccess>> access = filter_.TakeMessage();
-    if (access.is_present()) {
-      HandleMessage(access.get());
+// Writes to a temporary file first so that a reader never sees a partial
+// snapshot.
+bool MemoryProfiler::WriteSnapshotLocked(const string& path, Format format) {
+  const string temporary_path = path + ".tmp";
+  {
+    std::ofstream out(temporary_path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (format == CSV) {
+      heatmap_.WriteCSV(&out);
+    } else {
+      heatmap_.WriteBinary(&out);
+    }
+    if (!out) {
+      LOG(ERROR) << "Could not write memory profile to " << temporary_path;
+      return false;
     }
   }
+  if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    LOG(ERROR) << "Could not write memory profile to " << path;
+    return false;
+  }
+  return true;
 }
 
 } // namespace memory_profiler
 } // namespace debug
 } // namespace backend
-
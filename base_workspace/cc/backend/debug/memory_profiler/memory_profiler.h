@@ -1,21 +1,53 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_MEMORY_PROFILER_MEMORY_PROFILER_H_
 #define TURBO_SANTA_COMMON_BACK_END_DEBUG_MEMORY_PROFILER_MEMORY_PROFILER_H_
 
+#include <chrono>
+#include <mutex>
+#include <string>
+
 #include "cc/backend/debug/consumer.h"
 #include "cc/backend/debug/filter.h"
-#include "cc/backend/debug/memory_profiler/memory_access_filter.h"
+#include "cc/backend/debug/memory_profiler/heatmap.h"
 
 namespace backend {
 namespace debug {
 namespace memory_profiler {
 
+// Aggregates every memory access into a Heatmap, which can be written out
+// while the emulator runs.
 class MemoryProfiler : public Consumer {
  public:
+  enum Format {
+    CSV,
+    BINARY,
+  };
+
+  MemoryProfiler() { filter_.mutable_interest()->WatchAll(AddressInterest::READS_AND_WRITES); }
+
   void Run() override;
 
   FilterBase* filter_external() override { return &filter_; }
+
+  // Writes the counts so far to path. May be called from any thread.
+  bool WriteSnapshot(const std::string& path, Format format);
+
+  // Also writes a snapshot to path each time interval passes, as long as
+  // accesses are arriving. A zero interval turns this off.
+  void set_snapshot_interval(std::chrono::milliseconds interval, 
+                             const std::string& path,
+                             Format format);
+
  private:
-  MemoryAccessFilter filter_;
+  RecordFilter filter_;
+  // Guards heatmap_ and the snapshot settings; held once per batch.
+  std::mutex mutex_;
+  Heatmap heatmap_;
+  std::chrono::milliseconds snapshot_interval_{0};
+  std::string snapshot_path_;
+  Format snapshot_format_ = CSV;
+  std::chrono::steady_clock::time_point last_snapshot_;
+
+  bool WriteSnapshotLocked(const std::string& path, Format format);
 };
 
 } // namespace memory_profiler
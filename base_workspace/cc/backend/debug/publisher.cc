@@ -15,5 +15,20 @@ void Publisher::Publish(unique_ptr<Message> message) {
   }
 }
 
+void Publisher::PublishRecords(RecordSpan records) {
+  if (forwarder_ != nullptr) {
+    forwarder_->PublishRecords(std::move(records));
+  }
+}
+
+void Publisher::Flush() {
+  if (batch_ == nullptr) {
+    return;
+  }
+  RecordSpan records(batch_);
+  batch_ = nullptr;
+  PublishRecords(std::move(records));
+}
+
 } // namespace debug
 } // namespace backend
@@ -3,6 +3,9 @@
 
 #include <memory>
 #include <vector>
+#include "cc/backend/debug/access_record.h"
+#include "cc/backend/debug/address_interest.h"
+#include "cc/backend/debug/instrumentation.h"
 #include "cc/backend/debug/message.h"
 
 namespace backend {
@@ -11,25 +14,70 @@ namespace debug {
 class Publisher {
  public:
   virtual void Publish(std::unique_ptr<Message> message);
+  virtual void PublishRecords(RecordSpan records);
+
+  // Whether any consumer wants mode accesses to address.
+  bool Interested(AccessRecord::Mode mode, uint16_t address) const {
+    return interest_ != nullptr && interest_->Contains(mode, address);
+  }
+
+  // Copies record into this publisher's current batch, which is published
+  // once full. Records no consumer is interested in are dropped here.
+  void PublishRecord(const AccessRecord& record) {
+    if (!Interested(record.mode, record.address)) {
+      return;
+    }
+    if (batch_ == nullptr) {
+      batch_ = pool_.Acquire();
+    }
+    batch_->Append(record);
+    if (batch_->full()) {
+      Flush();
+    }
+  }
+
+  // Publishes the current batch even if it is only partly full.
+  void Flush();
+
   // Forward all messages to publisher.
-  virtual void ForwardTo(Publisher* publisher) { forwarder_ = publisher; }
+  virtual void ForwardTo(Publisher* publisher) {
+    forwarder_ = publisher;
+    interest_ = publisher->interest();
+  }
   // Have publisher forward to this.
   virtual void Own(Publisher* publisher) { publisher->ForwardTo(this); }
 
+  // The accesses which will be forwarded, or nullptr for none. Picked up from
+  // the publisher forwarded to when ForwardTo is called.
+  virtual const AddressInterest* interest() const { return interest_; }
+
  private:
   Publisher* forwarder_ = nullptr;
+  const AddressInterest* interest_ = nullptr;
   std::vector<std::unique_ptr<Message>> messages_;
+  RecordPool pool_;
+  RecordBatch* batch_ = nullptr;
 };
 
 } // namespace debug 
 } // namespace backend
 
-// If DEBUG is not defined, we do not want to publish messages since the
-// messages.
-#ifdef DEBUG
-  #define PUBLISH(message) Publish(message);
-#else
-  #define PUBLISH(message)
-#endif
+// Only evaluates message, and so only allocates it, when category is enabled.
+#define PUBLISH(category, message) \
+    do { \
+      if (backend::debug::Instrumentation::enabled(category)) { \
+        Publish(message); \
+      } \
+    } while (false)
+
+// The same for access records, which are batched instead of allocated. record
+// is also only evaluated when some consumer wants mode accesses to address.
+#define PUBLISH_RECORD(category, mode, address, record) \
+    do { \
+      if (backend::debug::Instrumentation::enabled(category) && \
+          Interested(mode, address)) { \
+        PublishRecord(record); \
+      } \
+    } while (false)
 
 #endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_PUBLISHER_H_
@@ -0,0 +1,185 @@
+#include "cc/backend/debug/trace/trace_format.h"
+
+#include <cstring>
+
+namespace backend {
+namespace debug {
+namespace trace {
+
+using std::vector;
+
+const char kFileMagic[4] = {'T', 'S', 'T', 'R'};
+const char kChunkMagic[4] = {'T', 'S', 'C', 'K'};
+const char kIndexMagic[4] = {'T', 'S', 'I', 'X'};
+const char kFooterMagic[4] = {'T', 'S', 'F', 'T'};
+
+namespace {
+
+const uint8_t kModeMask = 0b00000011;
+const uint8_t kBankChanged = 0b00000100;
+const uint8_t kPrefixed = 0b00001000;
+
+void PutVarint(vector<uint8_t>* out, uint64_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+const uint8_t* GetVarint(const uint8_t* in, const uint8_t* end, uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64 && in < end; shift += 7) {
+    uint8_t byte = *in++;
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return in;
+    }
+  }
+  return nullptr;
+}
+
+// Maps small negative numbers to small positive ones so they stay short.
+uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace
+
+void PutMagic(vector<uint8_t>* out, const char* magic) {
+  out->insert(out->end(), magic, magic + 4);
+}
+
+void PutFixed32(vector<uint8_t>* out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out->push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void PutFixed64(vector<uint8_t>* out, uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    out->push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+bool HasMagic(const uint8_t* in, const char* magic) {
+  return memcmp(in, magic, 4) == 0;
+}
+
+uint32_t GetFixed32(const uint8_t* in) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    value |= static_cast<uint32_t>(in[i]) << (8 * i);
+  }
+  return value;
+}
+
+uint64_t GetFixed64(const uint8_t* in) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; i++) {
+    value |= static_cast<uint64_t>(in[i]) << (8 * i);
+  }
+  return value;
+}
+
+void RecordEncoder::Encode(const AccessRecord& record, vector<uint8_t>* out) {
+  const bool is_instruction = record.mode == AccessRecord::INSTRUCTION;
+  uint16_t* last_address = is_instruction ? &instruction_address_ : &access_address_;
+  int16_t* last_bank = is_instruction ? &instruction_bank_ : &access_bank_;
+
+  uint8_t tag = record.mode;
+  if (record.bank != *last_bank) {
+    tag |= kBankChanged;
+  }
+  if (is_instruction && record.old_value != 0) {
+    tag |= kPrefixed;
+  }
+  out->push_back(tag);
+  PutVarint(out, ZigZag(static_cast<int64_t>(record.cycle - cycle_)));
+  PutVarint(out, ZigZag(static_cast<int16_t>(record.address - *last_address)));
+  if (tag & kBankChanged) {
+    PutVarint(out, ZigZag(record.bank));
+  }
+  switch (record.mode) {
+    case AccessRecord::READ:
+      out->push_back(record.old_value);
+      break;
+    case AccessRecord::WRITE:
+      out->push_back(record.old_value);
+      out->push_back(record.new_value);
+      break;
+    default:
+      if (tag & kPrefixed) {
+        out->push_back(record.old_value);
+      }
+      out->push_back(record.new_value);
+      break;
+  }
+
+  cycle_ = record.cycle;
+  *last_address = record.address;
+  *last_bank = record.bank;
+}
+
+const uint8_t* RecordDecoder::Decode(const uint8_t* in, const uint8_t* end, AccessRecord* record) {
+  if (in >= end) {
+    return nullptr;
+  }
+  const uint8_t tag = *in++;
+  if ((tag & kModeMask) >= AccessRecord::MODE_NUMBER) {
+    return nullptr;
+  }
+  record->mode = static_cast<AccessRecord::Mode>(tag & kModeMask);
+  const bool is_instruction = record->mode == AccessRecord::INSTRUCTION;
+  uint16_t* last_address = is_instruction ? &instruction_address_ : &access_address_;
+  int16_t* last_bank = is_instruction ? &instruction_bank_ : &access_bank_;
+
+  uint64_t value;
+  if ((in = GetVarint(in, end, &value)) == nullptr) {
+    return nullptr;
+  }
+  cycle_ += UnZigZag(value);
+  if ((in = GetVarint(in, end, &value)) == nullptr) {
+    return nullptr;
+  }
+  *last_address += static_cast<uint16_t>(UnZigZag(value));
+  if (tag & kBankChanged) {
+    if ((in = GetVarint(in, end, &value)) == nullptr) {
+      return nullptr;
+    }
+    *last_bank = static_cast<int16_t>(UnZigZag(value));
+  }
+
+  size_t value_bytes = 1;
+  if (record->mode == AccessRecord::WRITE || (tag & kPrefixed)) {
+    value_bytes = 2;
+  }
+  if (static_cast<size_t>(end - in) < value_bytes) {
+    return nullptr;
+  }
+  record->cycle = cycle_;
+  record->address = *last_address;
+  record->bank = *last_bank;
+  switch (record->mode) {
+    case AccessRecord::READ:
+      record->old_value = record->new_value = in[0];
+      break;
+    case AccessRecord::WRITE:
+      record->old_value = in[0];
+      record->new_value = in[1];
+      break;
+    default:
+      record->old_value = value_bytes == 2 ? in[0] : 0;
+      record->new_value = in[value_bytes - 1];
+      break;
+  }
+  return in + value_bytes;
+}
+
+} // namespace trace
+} // namespace debug
+} // namespace backend
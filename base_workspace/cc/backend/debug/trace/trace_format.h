@@ -0,0 +1,93 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_FORMAT_H_
+#define TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cc/backend/debug/access_record.h"
+
+namespace backend {
+namespace debug {
+namespace trace {
+
+// A trace file is laid out as
+//   header: "TSTR", version
+//   chunks: each a chunk header followed by its encoded records
+//   index:  "TSIX", chunk count, then each chunk's offset, first cycle and
+//           first record
+//   footer: index offset, chunk count, "TSFT"
+// with a chunk header being
+//   "TSCK", record count, payload bytes, reserved, first cycle, first record
+// Counts, bytes and the version are 32 bits, offsets, cycles and record
+// numbers 64 bits, all little endian. A trace whose writer never finished has
+// no index or footer; readers scan the chunk headers instead.
+//
+// Each record is a tag byte holding the mode and the kBankChanged and
+// kPrefixed flags, then as varints the change in cycle and the change in
+// address from the previous instruction (for instructions) or access (for
+// reads and writes), then the bank if it changed since that same record, then
+// the value read, the old and new values written or the opcode. Every chunk
+// starts from its header's first cycle and from address and bank zero, so
+// chunks decode independently.
+const uint32_t kVersion = 1;
+const size_t kFileHeaderSize = 8;
+const size_t kChunkHeaderSize = 32;
+const size_t kIndexHeaderSize = 8;
+const size_t kIndexEntrySize = 24;
+const size_t kFooterSize = 16;
+
+extern const char kFileMagic[4];
+extern const char kChunkMagic[4];
+extern const char kIndexMagic[4];
+extern const char kFooterMagic[4];
+
+struct ChunkInfo {
+  uint64_t offset; // Of the chunk header.
+  uint64_t first_cycle;
+  uint64_t first_record;
+  uint32_t record_count;
+};
+
+void PutMagic(std::vector<uint8_t>* out, const char* magic);
+void PutFixed32(std::vector<uint8_t>* out, uint32_t value);
+void PutFixed64(std::vector<uint8_t>* out, uint64_t value);
+bool HasMagic(const uint8_t* in, const char* magic);
+uint32_t GetFixed32(const uint8_t* in);
+uint64_t GetFixed64(const uint8_t* in);
+
+class RecordEncoder {
+ public:
+  explicit RecordEncoder(uint64_t first_cycle) : cycle_(first_cycle) {}
+
+  void Encode(const AccessRecord& record, std::vector<uint8_t>* out);
+
+ private:
+  uint64_t cycle_;
+  uint16_t instruction_address_ = 0;
+  uint16_t access_address_ = 0;
+  int16_t instruction_bank_ = 0;
+  int16_t access_bank_ = 0;
+};
+
+class RecordDecoder {
+ public:
+  explicit RecordDecoder(uint64_t first_cycle) : cycle_(first_cycle) {}
+
+  // Returns the start of the next record, or nullptr if the record is
+  // malformed or runs past end.
+  const uint8_t* Decode(const uint8_t* in, const uint8_t* end, AccessRecord* record);
+
+ private:
+  uint64_t cycle_;
+  uint16_t instruction_address_ = 0;
+  uint16_t access_address_ = 0;
+  int16_t instruction_bank_ = 0;
+  int16_t access_bank_ = 0;
+};
+
+} // namespace trace
+} // namespace debug
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_FORMAT_H_
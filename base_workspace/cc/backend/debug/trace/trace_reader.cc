@@ -0,0 +1,163 @@
+#include "cc/backend/debug/trace/trace_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "glog/logging.h"
+
+namespace backend {
+namespace debug {
+namespace trace {
+
+using std::string;
+using std::vector;
+
+TraceReader::~TraceReader() {
+  Close();
+}
+
+bool TraceReader::Open(const string& path) {
+  Close();
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(ERROR) << "Cannot open trace " << path << ": " << strerror(errno);
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(kFileHeaderSize)) {
+    LOG(ERROR) << path << " is not a trace.";
+    close(fd);
+    return false;
+  }
+  void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG(ERROR) << "Cannot map trace " << path << ": " << strerror(errno);
+    return false;
+  }
+  data_ = static_cast<const uint8_t*>(data);
+  size_ = file_stat.st_size;
+
+  if (!HasMagic(data_, kFileMagic) || GetFixed32(data_ + 4) != kVersion) {
+    LOG(ERROR) << path << " is not a version " << kVersion << " trace.";
+    Close();
+    return false;
+  }
+  if (!ReadIndex()) {
+    LOG(WARNING) << path << " has no index, it was probably not finished.";
+    ScanChunks();
+  }
+  return true;
+}
+
+void TraceReader::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  chunks_.clear();
+}
+
+uint64_t TraceReader::record_number() const {
+  if (chunks_.empty()) {
+    return 0;
+  }
+  return chunks_.back().first_record + chunks_.back().record_count;
+}
+
+size_t TraceReader::FindChunkByCycle(uint64_t cycle) const {
+  auto after = std::upper_bound(chunks_.begin(), chunks_.end(), cycle,
+                                [](uint64_t cycle, const ChunkInfo& info) {
+                                  return cycle < info.first_cycle;
+                                });
+  return after == chunks_.begin() ? 0 : after - chunks_.begin() - 1;
+}
+
+size_t TraceReader::FindChunkByRecord(uint64_t record) const {
+  auto after = std::upper_bound(chunks_.begin(), chunks_.end(), record,
+                                [](uint64_t record, const ChunkInfo& info) {
+                                  return record < info.first_record;
+                                });
+  return after == chunks_.begin() ? 0 : after - chunks_.begin() - 1;
+}
+
+bool TraceReader::ReadChunk(size_t chunk, vector<AccessRecord>* records) const {
+  records->clear();
+  if (chunk >= chunks_.size()) {
+    return false;
+  }
+  const ChunkInfo& info = chunks_[chunk];
+  const uint8_t* in = data_ + info.offset + kChunkHeaderSize;
+  const uint8_t* end = in + GetFixed32(data_ + info.offset + 8);
+  records->resize(info.record_count);
+  RecordDecoder decoder(info.first_cycle);
+  for (AccessRecord& record : *records) {
+    if ((in = decoder.Decode(in, end, &record)) == nullptr) {
+      LOG(ERROR) << "Chunk " << chunk << " of the trace is corrupt.";
+      records->clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TraceReader::ReadIndex() {
+  if (size_ < kFileHeaderSize + kIndexHeaderSize + kFooterSize) {
+    return false;
+  }
+  const uint8_t* footer = data_ + size_ - kFooterSize;
+  if (!HasMagic(footer + 12, kFooterMagic)) {
+    return false;
+  }
+  const uint64_t index_offset = GetFixed64(footer);
+  const uint32_t chunk_count = GetFixed32(footer + 8);
+  if (index_offset + kIndexHeaderSize + chunk_count * kIndexEntrySize + kFooterSize != size_ ||
+      !HasMagic(data_ + index_offset, kIndexMagic)) {
+    return false;
+  }
+  const uint8_t* entry = data_ + index_offset + kIndexHeaderSize;
+  for (uint32_t i = 0; i < chunk_count; i++, entry += kIndexEntrySize) {
+    ChunkInfo info;
+    if (!ReadChunkHeader(GetFixed64(entry), &info)) {
+      chunks_.clear();
+      return false;
+    }
+    chunks_.push_back(info);
+  }
+  return true;
+}
+
+void TraceReader::ScanChunks() {
+  uint64_t offset = kFileHeaderSize;
+  ChunkInfo info;
+  while (ReadChunkHeader(offset, &info)) {
+    chunks_.push_back(info);
+    offset += kChunkHeaderSize + GetFixed32(data_ + offset + 8);
+  }
+}
+
+bool TraceReader::ReadChunkHeader(uint64_t offset, ChunkInfo* info) const {
+  if (offset + kChunkHeaderSize > size_ || !HasMagic(data_ + offset, kChunkMagic)) {
+    return false;
+  }
+  const uint8_t* header = data_ + offset;
+  if (offset + kChunkHeaderSize + GetFixed32(header + 8) > size_) {
+    return false; // Cut off part way through.
+  }
+  info->offset = offset;
+  info->record_count = GetFixed32(header + 4);
+  info->first_cycle = GetFixed64(header + 16);
+  info->first_record = GetFixed64(header + 24);
+  return true;
+}
+
+} // namespace trace
+} // namespace debug
+} // namespace backend
@@ -0,0 +1,59 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_READER_H_
+#define TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cc/backend/debug/access_record.h"
+#include "cc/backend/debug/trace/trace_format.h"
+
+namespace backend {
+namespace debug {
+namespace trace {
+
+// Memory maps a trace written by TraceWriter. Chunks are found through the
+// index, so any part of a trace can be decoded without reading what comes
+// before it.
+class TraceReader {
+ public:
+  TraceReader() = default;
+  TraceReader(const TraceReader&) = delete;
+  TraceReader& operator=(const TraceReader&) = delete;
+  ~TraceReader();
+
+  // Returns false if path cannot be mapped or is not a trace. A trace which
+  // was never finished is read up to its last complete chunk.
+  bool Open(const std::string& path);
+
+  const std::vector<ChunkInfo>& chunks() const { return chunks_; }
+
+  uint64_t record_number() const;
+
+  // The last chunk starting at or before cycle, which is where to start
+  // reading to find the records from cycle on.
+  size_t FindChunkByCycle(uint64_t cycle) const;
+
+  // The chunk holding the record-th record.
+  size_t FindChunkByRecord(uint64_t record) const;
+
+  // Replaces records with every record in the chunk.
+  bool ReadChunk(size_t chunk, std::vector<AccessRecord>* records) const;
+
+ private:
+  bool ReadIndex();
+  void ScanChunks();
+  bool ReadChunkHeader(uint64_t offset, ChunkInfo* info) const;
+  void Close();
+
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  std::vector<ChunkInfo> chunks_;
+};
+
+} // namespace trace
+} // namespace debug
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_READER_H_
@@ -0,0 +1,171 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cc/backend/debug/master.h"
+#include "cc/backend/debug/publisher.h"
+#include "cc/backend/debug/trace/trace_reader.h"
+#include "cc/backend/debug/trace/trace_writer.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace debug {
+namespace trace {
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace {
+
+string TemporaryPath(const string& name) {
+  const char* directory = getenv("TEST_TMPDIR");
+  return string(directory == nullptr ? "/tmp" : directory) + "/" + name;
+}
+
+// A little program: an instruction followed by the accesses it makes, with
+// the occasional jump and bank switch.
+vector<AccessRecord> MakeRecords(size_t number) {
+  vector<AccessRecord> records;
+  uint64_t cycle = 1000;
+  uint16_t pc = 0x0100;
+  int16_t bank = 1;
+  for (size_t i = 0; records.size() < number; i++) {
+    if (i % 5000 == 0) {
+      bank = (bank % 7) + 1;
+      pc = 0x4000 + (i % 0x3000);
+    }
+    records.push_back(AccessRecord::Instruction(pc, i % 11 == 0 ? 0xcb37 : 0x00 + (i & 0xff),
+                                                pc >= 0x4000 ? bank : 0, cycle));
+    if (i % 3 == 0) {
+      records.push_back(AccessRecord::Read(0xff44, i & 0xff, 0, cycle));
+    } else if (i % 3 == 1) {
+      records.push_back(AccessRecord::Write(0xc000 + (i & 0x1fff), i & 0xff, ~i & 0xff, 0, cycle));
+    }
+    pc += 1 + i % 3;
+    cycle += 4 + 4 * (i % 5);
+  }
+  records.resize(number);
+  return records;
+}
+
+void WriteTrace(const string& path, const vector<AccessRecord>& records) {
+  // The publisher owns the batches, so it has to outlive the master.
+  Publisher publisher;
+  Master master;
+  master.Register(unique_ptr<Consumer>(new TraceWriter(path)));
+  master.Own(&publisher);
+  for (const AccessRecord& record : records) {
+    publisher.PublishRecord(record);
+  }
+  publisher.Flush();
+  // Destroying the master finishes the trace.
+}
+
+void ExpectSameRecord(const AccessRecord& expected, const AccessRecord& actual) {
+  EXPECT_EQ(expected.mode, actual.mode);
+  EXPECT_EQ(expected.cycle, actual.cycle);
+  EXPECT_EQ(expected.address, actual.address);
+  EXPECT_EQ(expected.old_value, actual.old_value);
+  EXPECT_EQ(expected.new_value, actual.new_value);
+  EXPECT_EQ(expected.bank, actual.bank);
+}
+
+} // namespace
+
+TEST(TraceTest, ReadsBackWhatWasWritten) {
+  const string path = TemporaryPath("trace_test.trace");
+  const vector<AccessRecord> records = MakeRecords(3 * TraceWriter::kChunkRecords + 17);
+  WriteTrace(path, records);
+
+  TraceReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ASSERT_EQ(4u, reader.chunks().size());
+  EXPECT_EQ(records.size(), reader.record_number());
+
+  vector<AccessRecord> chunk;
+  size_t next = 0;
+  for (size_t i = 0; i < reader.chunks().size(); i++) {
+    ASSERT_TRUE(reader.ReadChunk(i, &chunk));
+    for (const AccessRecord& record : chunk) {
+      ExpectSameRecord(records[next++], record);
+    }
+  }
+  EXPECT_EQ(records.size(), next);
+  EXPECT_EQ(0xcb37, records[0].opcode());
+
+  // Records take a few bytes each, rather than the sixteen they take in memory.
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  EXPECT_LT(static_cast<size_t>(file.tellg()), records.size() * 8);
+  remove(path.c_str());
+}
+
+TEST(TraceTest, SeeksToChunks) {
+  const string path = TemporaryPath("trace_seek_test.trace");
+  const vector<AccessRecord> records = MakeRecords(2 * TraceWriter::kChunkRecords + 1);
+  WriteTrace(path, records);
+
+  TraceReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ASSERT_EQ(3u, reader.chunks().size());
+  const uint64_t middle = TraceWriter::kChunkRecords + 10;
+  const size_t chunk_index = reader.FindChunkByRecord(middle);
+  EXPECT_EQ(1u, chunk_index);
+  EXPECT_EQ(1u, reader.FindChunkByCycle(records[middle].cycle));
+  EXPECT_EQ(0u, reader.FindChunkByCycle(0));
+  EXPECT_EQ(2u, reader.FindChunkByCycle(records.back().cycle + 100));
+
+  vector<AccessRecord> chunk;
+  ASSERT_TRUE(reader.ReadChunk(chunk_index, &chunk));
+  ExpectSameRecord(records[middle], chunk[middle - reader.chunks()[chunk_index].first_record]);
+  remove(path.c_str());
+}
+
+TEST(TraceTest, ReadsUnfinishedTraces) {
+  const string path = TemporaryPath("trace_unfinished_test.trace");
+  const vector<AccessRecord> records = MakeRecords(2 * TraceWriter::kChunkRecords);
+  WriteTrace(path, records);
+
+  // Drop the index and footer and cut the last chunk short.
+  string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  TraceReader finished;
+  ASSERT_TRUE(finished.Open(path));
+  ASSERT_EQ(2u, finished.chunks().size());
+  bytes.resize(finished.chunks()[1].offset + 100);
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << bytes;
+  }
+
+  TraceReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ASSERT_EQ(1u, reader.chunks().size());
+  vector<AccessRecord> chunk;
+  ASSERT_TRUE(reader.ReadChunk(0, &chunk));
+  ASSERT_EQ(TraceWriter::kChunkRecords, chunk.size());
+  ExpectSameRecord(records[TraceWriter::kChunkRecords - 1], chunk.back());
+  remove(path.c_str());
+}
+
+TEST(TraceTest, RejectsOtherFiles) {
+  const string path = TemporaryPath("trace_not_a_trace");
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "definitely not a trace";
+  }
+  TraceReader reader;
+  EXPECT_FALSE(reader.Open(path));
+  EXPECT_FALSE(reader.Open(TemporaryPath("trace_does_not_exist")));
+  remove(path.c_str());
+}
+
+} // namespace trace
+} // namespace debug
+} // namespace backend
@@ -0,0 +1,144 @@
+#include "cc/backend/debug/trace/trace_writer.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include "cc/utility/option.h"
+#include "glog/logging.h"
+
+namespace backend {
+namespace debug {
+namespace trace {
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+using utility::Option;
+
+namespace {
+// Enough for the writer thread to fall a little behind without the encoder
+// waiting on it.
+const size_t kQueuedChunks = 8;
+} // namespace
+
+const uint32_t TraceWriter::kChunkRecords;
+
+TraceWriter::TraceWriter(const string& path) :
+    path_(path),
+    full_chunks_(kQueuedChunks, ChunkBuffer::BLOCK, 1) {
+  filter_.mutable_interest()->WatchAll(AddressInterest::READS_AND_WRITES |
+                                       AddressInterest::INSTRUCTIONS);
+}
+
+void TraceWriter::Run() {
+  writer_thread_ = std::thread([this]() { WriteChunks(); });
+  const AddressInterest* interest = filter_.interest();
+  for (;;) {
+    Option<RecordSpan> records = filter_.TakeRecords();
+    if (!records.is_present()) {
+      break; // Closed and drained.
+    }
+    for (const AccessRecord& record : records.get()) {
+      // The batch may hold records only other consumers asked for.
+      if (!interest->Contains(record)) {
+        continue;
+      }
+      if (chunk_ == nullptr) {
+        StartChunk(record.cycle);
+      }
+      encoder_->Encode(record, &chunk_->payload);
+      chunk_->info.record_count++;
+      records_++;
+      if (chunk_->info.record_count == kChunkRecords) {
+        EndChunk();
+      }
+    }
+  }
+  if (chunk_ != nullptr) {
+    EndChunk();
+  }
+  full_chunks_.Close();
+  writer_thread_.join();
+}
+
+void TraceWriter::StartChunk(uint64_t first_cycle) {
+  chunk_ = shared_ptr<Chunk>(new Chunk());
+  chunk_->info.first_cycle = first_cycle;
+  chunk_->info.first_record = records_;
+  chunk_->info.record_count = 0;
+  // Most records take four or five bytes.
+  chunk_->payload.reserve(kChunkRecords * 5);
+  encoder_ = std::unique_ptr<RecordEncoder>(new RecordEncoder(first_cycle));
+}
+
+void TraceWriter::EndChunk() {
+  full_chunks_.Put(chunk_);
+  chunk_ = nullptr;
+}
+
+void TraceWriter::WriteChunks() {
+  file_ = fopen(path_.c_str(), "wb");
+  if (file_ == nullptr) {
+    LOG(ERROR) << "Cannot write trace to " << path_ << ": " << strerror(errno);
+  }
+  vector<uint8_t> bytes;
+  PutMagic(&bytes, kFileMagic);
+  PutFixed32(&bytes, kVersion);
+  Write(bytes);
+
+  for (;;) {
+    Option<shared_ptr<Chunk>> taken = full_chunks_.Take();
+    if (!taken.is_present()) {
+      break;
+    }
+    Chunk* chunk = taken.get().get();
+    chunk->info.offset = offset_;
+    bytes.clear();
+    PutMagic(&bytes, kChunkMagic);
+    PutFixed32(&bytes, chunk->info.record_count);
+    PutFixed32(&bytes, chunk->payload.size());
+    PutFixed32(&bytes, 0);
+    PutFixed64(&bytes, chunk->info.first_cycle);
+    PutFixed64(&bytes, chunk->info.first_record);
+    if (Write(bytes) && Write(chunk->payload)) {
+      index_.push_back(chunk->info);
+    }
+  }
+
+  bytes.clear();
+  const uint64_t index_offset = offset_;
+  PutMagic(&bytes, kIndexMagic);
+  PutFixed32(&bytes, index_.size());
+  for (const ChunkInfo& info : index_) {
+    PutFixed64(&bytes, info.offset);
+    PutFixed64(&bytes, info.first_cycle);
+    PutFixed64(&bytes, info.first_record);
+  }
+  PutFixed64(&bytes, index_offset);
+  PutFixed32(&bytes, index_.size());
+  PutMagic(&bytes, kFooterMagic);
+  Write(bytes);
+
+  if (file_ != nullptr && fclose(file_) != 0) {
+    LOG(ERROR) << "Cannot write trace to " << path_ << ": " << strerror(errno);
+  }
+  file_ = nullptr;
+}
+
+bool TraceWriter::Write(const vector<uint8_t>& bytes) {
+  if (file_ == nullptr) {
+    return false;
+  }
+  if (fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size()) {
+    LOG(ERROR) << "Cannot write trace to " << path_ << ": " << strerror(errno);
+    fclose(file_);
+    file_ = nullptr;
+    return false;
+  }
+  offset_ += bytes.size();
+  return true;
+}
+
+} // namespace trace
+} // namespace debug
+} // namespace backend
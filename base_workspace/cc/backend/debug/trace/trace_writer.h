@@ -0,0 +1,71 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_WRITER_H_
+#define TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_WRITER_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cc/backend/debug/address_interest.h"
+#include "cc/backend/debug/consumer.h"
+#include "cc/backend/debug/filter.h"
+#include "cc/backend/debug/trace/trace_format.h"
+#include "cc/utility/ring_buffer.h"
+
+namespace backend {
+namespace debug {
+namespace trace {
+
+// Encodes the records it is sent into a trace file (see trace_format.h). The
+// consumer thread only encodes; full chunks are handed to a second thread
+// which does the writing. The index and footer are written once the filter
+// is closed, which Master does when it is destroyed.
+class TraceWriter : public Consumer {
+ public:
+  static const uint32_t kChunkRecords = 1 << 16;
+
+  // Traces every read, write and instruction unless mutable_interest() is
+  // changed before the writer is registered.
+  explicit TraceWriter(const std::string& path);
+
+  void Run() override;
+
+  FilterBase* filter_external() override { return &filter_; }
+
+  AddressInterest* mutable_interest() { return filter_.mutable_interest(); }
+
+ private:
+  struct Chunk {
+    ChunkInfo info;
+    std::vector<uint8_t> payload;
+  };
+
+  typedef utility::RingBuffer<std::shared_ptr<Chunk>> ChunkBuffer;
+
+  void StartChunk(uint64_t first_cycle);
+  void EndChunk();
+  // Runs on writer_thread_.
+  void WriteChunks();
+  bool Write(const std::vector<uint8_t>& bytes);
+
+  const std::string path_;
+  RecordFilter filter_;
+  uint64_t records_ = 0;
+  std::shared_ptr<Chunk> chunk_;
+  std::unique_ptr<RecordEncoder> encoder_;
+  ChunkBuffer full_chunks_;
+  std::thread writer_thread_;
+
+  // Only used by writer_thread_.
+  FILE* file_ = nullptr;
+  uint64_t offset_ = 0;
+  std::vector<ChunkInfo> index_;
+};
+
+} // namespace trace
+} // namespace debug
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_DEBUG_TRACE_TRACE_WRITER_H_
@@ -7,7 +7,7 @@
 namespace backend {
 namespace decompiler {
 
-enum class Opcode {
+enum class Opcode : uint8_t {
   ADC,
   ADD,
   AND,
@@ -56,7 +56,7 @@ enum class Opcode {
   XOR,
 };
 
-enum class Register {
+enum class Register : uint8_t {
   A,
   B,
   C,
@@ -89,7 +89,7 @@ union ArgumentValue {
   uint16_t val;
 };
 
-enum class ArgumentType {
+enum class ArgumentType : uint8_t {
   REGISTER,
   VALUE,
   EMPTY
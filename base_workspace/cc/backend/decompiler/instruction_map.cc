@@ -420,7 +420,7 @@ std::vector<InstructionFactory> CreateFactoryList() {
   list.push_back(instr(RES, 0xcb85, 8, bit(), val(L), BIT_16));
   list.push_back(instr(RES, 0xcb86, 16, bit(), ptr(HL), BIT_16));
 
-  list.push_back(jump(JP, 0xc3, 12, val(BIT_16)));
+  list.push_back(jump(JP, 0xc3, 16, val(BIT_16)));
 
   list.push_back(jump(JP, 0xc2, 12, val(ZN), val(BIT_16)));
   list.push_back(jump(JP, 0xca, 12, val(ZF), val(BIT_16)));
@@ -429,37 +429,37 @@ std::vector<InstructionFactory> CreateFactoryList() {
 
   list.push_back(jump(JP, 0xe9, 4, ptr(HL)));
 
-  list.push_back(jump(JR, 0x18, 8, val(BIT_8)));
+  list.push_back(jump(JR, 0x18, 12, val(BIT_8)));
 
   list.push_back(jump(JR, 0x20, 8, val(ZN), val(BIT_8)));
   list.push_back(jump(JR, 0x28, 8, val(ZF), val(BIT_8)));
   list.push_back(jump(JR, 0x30, 8, val(CN), val(BIT_8)));
   list.push_back(jump(JR, 0x38, 8, val(CF), val(BIT_8)));
 
-  list.push_back(jump(CALL, 0xcd, 12, val(BIT_16)));
+  list.push_back(jump(CALL, 0xcd, 24, val(BIT_16)));
 
   list.push_back(jump(CALL, 0xc4, 12, val(ZN), val(BIT_16)));
   list.push_back(jump(CALL, 0xcc, 12, val(ZF), val(BIT_16)));
   list.push_back(jump(CALL, 0xd4, 12, val(CN), val(BIT_16)));
   list.push_back(jump(CALL, 0xdc, 12, val(CF), val(BIT_16)));
 
-  list.push_back(jump(RST, 0xc7, 32, con(0x00)));
-  list.push_back(jump(RST, 0xcf, 32, con(0x08)));
-  list.push_back(jump(RST, 0xd7, 32, con(0x10)));
-  list.push_back(jump(RST, 0xdf, 32, con(0x18)));
-  list.push_back(jump(RST, 0xe7, 32, con(0x20)));
-  list.push_back(jump(RST, 0xef, 32, con(0x28)));
-  list.push_back(jump(RST, 0xf7, 32, con(0x30)));
-  list.push_back(jump(RST, 0xff, 32, con(0x38)));
+  list.push_back(jump(RST, 0xc7, 16, con(0x00)));
+  list.push_back(jump(RST, 0xcf, 16, con(0x08)));
+  list.push_back(jump(RST, 0xd7, 16, con(0x10)));
+  list.push_back(jump(RST, 0xdf, 16, con(0x18)));
+  list.push_back(jump(RST, 0xe7, 16, con(0x20)));
+  list.push_back(jump(RST, 0xef, 16, con(0x28)));
+  list.push_back(jump(RST, 0xf7, 16, con(0x30)));
+  list.push_back(jump(RST, 0xff, 16, con(0x38)));
 
-  list.push_back(jump(RET, 0xc9, 8));
+  list.push_back(jump(RET, 0xc9, 16));
 
   list.push_back(jump(RET, 0xc0, 8, val(ZN)));
   list.push_back(jump(RET, 0xc8, 8, val(ZF)));
   list.push_back(jump(RET, 0xd0, 8, val(CN)));
   list.push_back(jump(RET, 0xd8, 8, val(CF)));
 
-  list.push_back(jump(RETI, 0xd9, 8));
+  list.push_back(jump(RETI, 0xd9, 16));
   return list;
 }
 } // namespace
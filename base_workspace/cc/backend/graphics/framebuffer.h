@@ -0,0 +1,40 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_FRAMEBUFFER_H_
+#define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_FRAMEBUFFER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "cc/backend/graphics/screen.h"
+
+namespace backend {
+namespace graphics {
+
+// One frame of realized shades, row major, exactly the size of the screen.
+// Unlike a ScreenRaster, accesses are neither virtual nor bounds checked; the
+// renderer is responsible for clipping.
+class Framebuffer {
+ public:
+  static const int kHeight = ScreenRaster::kScreenHeight;
+  static const int kWidth = ScreenRaster::kScreenWidth;
+
+  Framebuffer() : data_(kWidth * kHeight, 0x00) {}
+
+  uint8_t Get(int y, int x) const { return data_[x + y * kWidth]; }
+
+  void Set(int y, int x, uint8_t value) { data_[x + y * kWidth] = value; }
+
+  uint8_t* row(int y) { return data_.data() + y * kWidth; }
+
+  void Clear() { std::fill(data_.begin(), data_.end(), 0x00); }
+
+  const uint8_t* data() const { return data_.data(); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+} // namespace graphics
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_GRAPHICS_FRAMEBUFFER_H_
@@ -1,320 +1,291 @@
 #include "cc/backend/graphics/graphics_controller.h"
 
-#include <ncurses.h>
+#include <algorithm>
+#include <cstring>
 
+#include "cc/backend/debug/diagnostics.h"
+#include "cc/backend/graphics/pixel_kernels.h"
 #include "glog/logging.h"
 
 namespace backend {
 namespace graphics {
 
-using std::vector;
-using memory::BackgroundMap;
 using memory::OAMSegment;
 using memory::SpriteAttribute;
-using memory::Tile;
+using memory::TileCache;
 using memory::TileData;
 using memory::VRAMSegment;
 
 namespace {
-class TileReflectedX : public Tile {
- public:
-  TileReflectedX() : tile_(nullptr) {}
-
-  TileReflectedX(Tile* tile) : tile_(tile) {}
-
-  virtual unsigned char Get(unsigned int y, unsigned int x) {
-    return tile_->Get(y, Tile::kTileSize - 1 - x);
-  }
-
-  virtual void Set(unsigned int y, unsigned int x, unsigned char value) {
-    tile_->Set(y, Tile::kTileSize - 1 - x, value);
-  }
-
-  void set_tile(Tile* tile) { tile_ = tile; }
-
- private:
-  Tile* tile_;
+// The shade each color index of a palette is realized as. Color 0 of a sprite
+// palette is transparent, which the sprite kernel takes care of.
+struct Shades {
+  unsigned char shade[4];
 };
 
-class TileReflectedY : public Tile {
- public:
-  TileReflectedY() : tile_(nullptr) {}
-
-  TileReflectedY(Tile* tile) : tile_(tile) {}
-
-  virtual unsigned char Get(unsigned int y, unsigned int x) {
-    return tile_->Get(Tile::kTileSize - 1 - y, x);
+Shades LookUpShades(MonochromePalette* palette) {
+  Shades shades;
+  for (int i = 0; i < 4; i++) {
+    MonochromePalette::Color color = palette->lookup(i);
+    // Realizes a color as one of four evenly spaced shades.
+    shades.shade[i] = color != MonochromePalette::NONE ? static_cast<unsigned char>(color) * (256 / 4) : 0;
   }
+  return shades;
+}
 
-  virtual void Set(unsigned int y, unsigned int x, unsigned char value) {
-    tile_->Set(Tile::kTileSize - 1 - y, x, value);
+// The background and window share their tile data; 1 selects 0x8000-0x8fff,
+// indexed by unsigned tile numbers, and 0 selects 0x8800-0x97ff, indexed by
+// signed ones.
+TileData* SelectTileData(LCDControl* lcd_control, VRAMSegment* vram_segment) {
+  if (lcd_control->bg_window_tile_data_select()) {
+    return vram_segment->lower_tile_data();
+  } else {
+    return vram_segment->upper_tile_data();
   }
+}
 
-  void set_tile(Tile* tile) { tile_ = tile; }
+// Copies the color indices of width pixels of line plane_y of plane into
+// indices, starting at column plane_x and wrapping around.
+void FetchPlaneLine(TileMapPlane* plane, 
+                    TileData* tile_data, 
+                    int plane_y, 
+                    int plane_x, 
+                    int width, 
+                    unsigned char* indices) {
+  const unsigned char* line = plane->line(plane_y, tile_data);
+  const int first_width = std::min(width, TileMapPlane::kSize - plane_x);
+  memcpy(indices, line + plane_x, first_width);
+  memcpy(indices + first_width, line, width - first_width);
+}
 
- private:
-  Tile* tile_;
-};
+// Draws the sprites which OAM scan found on screen line y over row. A sprite
+// behind the background only shows through where the background's color
+// index, given by indices, is 0. Sprites are drawn lowest priority first.
+void RenderSpriteLine(GraphicsFlags* graphics_flags, 
+                      OAMSegment* oam_segment, 
+                      OAMScan* oam_scan, 
+                      VRAMSegment* vram_segment, 
+                      int y, 
+                      const unsigned char* indices, 
+                      uint8_t* row) {
+  TileCache* tile_cache = vram_segment->tile_cache();
+  const Shades shades[2] = {
+    LookUpShades(graphics_flags->object_palette_0()),
+    LookUpShades(graphics_flags->object_palette_1()),
+  };
+  // In 8x16 mode a sprite is an even tile with the following tile below it.
+  const bool is_tall = graphics_flags->lcd_control()->sprite_size();
+  const int sprite_height = is_tall ? 2 * TileCache::kTileSize : TileCache::kTileSize;
+  oam_scan->Update(sprite_height);
+
+  const PixelKernels& kernels = Kernels();
+  const unsigned char* sprites = oam_scan->sprites(y);
+  for (int i = oam_scan->sprite_number(y) - 1; i >= 0; i--) {
+    SpriteAttribute* sprite_attribute = oam_segment->sprite_attribute(sprites[i]);
+    const int x_offset = sprite_attribute->x() - kSpriteXOffset;
+    if (x_offset <= -TileCache::kTileSize || x_offset >= Framebuffer::kWidth) {
+      continue;
+    }
 
-void RenderTile(Tile* tile, 
-                unsigned char y_offset, 
-                unsigned char x_offset, 
-                MonochromePalette* palette, 
-                vector<unsigned char>* screen_buffer_) {
-  TileReflectedX x_flip(tile);
-  tile = &x_flip;
-  for (int y = 0; y < Tile::kTileSize; y++) {
-    for (int x = 0; x < Tile::kTileSize; x++) {
-      unsigned char color_index = tile->Get(y, x);
-      MonochromePalette::Color color = palette->lookup(color_index);
-      if (color != MonochromePalette::NONE) {
-        unsigned char realized_color = static_cast<unsigned char>(color) * (256 / 4);
-        (*screen_buffer_)[(x + x_offset) + (y + y_offset) * kScreenBufferSize] = realized_color;
-      }
+    int sprite_y = y - (sprite_attribute->y() - kSpriteYOffset);
+    if (sprite_attribute->y_flip()) {
+      sprite_y = sprite_height - 1 - sprite_y;
     }
+    unsigned char tile_number = sprite_attribute->tile_index();
+    if (is_tall) {
+      tile_number = (tile_number & 0b11111110) + sprite_y / TileCache::kTileSize;
+    }
+    const int tile_index = vram_segment->lower_tile_data()->tile_index(tile_number);
+    const unsigned char* tile_row = tile_cache->row(tile_index, sprite_y % TileCache::kTileSize, sprite_attribute->x_flip());
+    const int x_begin = std::max(0, -x_offset);
+    const int x_end = std::min(TileCache::kTileSize, Framebuffer::kWidth - x_offset);
+    kernels.map_sprite_shades(tile_row + x_begin, 
+                              indices + x_offset + x_begin, 
+                              x_end - x_begin, 
+                              sprite_attribute->behind_background(), 
+                              shades[sprite_attribute->palette() ? 1 : 0].shade, 
+                              row + x_offset + x_begin);
   }
 }
 
-void RenderSprite(SpriteAttribute* sprite_attribute, 
-                  GraphicsFlags* graphics_flags, 
-                  VRAMSegment* vram_segment, 
-                  vector<unsigned char>* screen_buffer_) {
-  TileReflectedX tile_reflected_x;
-  TileReflectedY tile_reflected_y;
-  Tile* tile = vram_segment->lower_tile_data()->tile(sprite_attribute->tile_index());
-
-  // Reflect the tile as appropriate.
-  if (sprite_attribute->x_flip()) {
-    tile_reflected_x.set_tile(tile);
-    tile = &tile_reflected_x;
-  }
-  if (sprite_attribute->y_flip()) {
-    tile_reflected_y.set_tile(tile);
-    tile = &tile_reflected_y;
-  }
+// Draws screen line y in a single pass. The color index under every pixel is
+// gathered from the background, and the window over it, first, so that each
+// pixel's shade is written once and then only overwritten by sprites.
+// window_line is the line of the window drawn if the window covers screen line
+// y; returns whether it did.
+bool RenderLine(GraphicsFlags* graphics_flags, 
+                OAMSegment* oam_segment, 
+                OAMScan* oam_scan, 
+                VRAMSegment* vram_segment, 
+                TileMapPlane* planes, 
+                int y, 
+                int window_line, 
+                Framebuffer* framebuffer) {
+  LCDControl* lcd_control = graphics_flags->lcd_control();
+  uint8_t* row = framebuffer->row(y);
+  unsigned char indices[Framebuffer::kWidth] = {};
+  bool window_drawn = false;
+
+  // Clearing BG display blanks the window as well as the background.
+  if (lcd_control->bg_display()) {
+    TileData* tile_data = SelectTileData(lcd_control, vram_segment);
+    const int scroll_y = graphics_flags->scroll_y()->flag();
+    const int scroll_x = graphics_flags->scroll_x()->flag();
+    FetchPlaneLine(&planes[lcd_control->bg_tile_map_display_select()], tile_data, 
+                   (y + scroll_y) % TileMapPlane::kSize, scroll_x, Framebuffer::kWidth, indices);
+
+    // The window is not scrolled; its top left corner is at (WY, WX - 7) on
+    // the screen and it covers everything below and to the right of that.
+    const int window_y = graphics_flags->window_y_position()->flag();
+    const int window_x = graphics_flags->window_x_position()->flag() - kWindowXOffset;
+    if (lcd_control->window_display_enable() && y >= window_y && window_x < Framebuffer::kWidth) {
+      const int x_begin = std::max(window_x, 0);
+      FetchPlaneLine(&planes[lcd_control->window_tile_map_display_select()], tile_data, 
+                     window_line, x_begin - window_x, Framebuffer::kWidth - x_begin, indices + x_begin);
+      window_drawn = true;
+    }
 
-  // Select color palette.
-  MonochromePalette* palette;
-  if (sprite_attribute->palette()) {
-    palette = graphics_flags->object_palette_1();
+    const Shades shades = LookUpShades(graphics_flags->background_palette());
+    Kernels().map_shades(indices, Framebuffer::kWidth, shades.shade, row);
   } else {
-    palette = graphics_flags->object_palette_0();
+    std::fill(row, row + Framebuffer::kWidth, 0x00);
   }
 
-  RenderTile(tile, sprite_attribute->y(), sprite_attribute->x(), palette, screen_buffer_);
+  if (lcd_control->sprite_display_enable()) {
+    RenderSpriteLine(graphics_flags, oam_segment, oam_scan, vram_segment, y, indices, row);
+  }
+  return window_drawn;
 }
+} // namespace
 
-void WriteToScreen(GraphicsFlags* graphics_flags, Screen* screen, vector<unsigned char>* screen_buffer_) {
-  ScreenRaster* raster = screen->mutable_raster();
-  const int y_offset = graphics_flags->scroll_y()->flag();
-  const int x_offset = graphics_flags->scroll_x()->flag();
-  for (int y = 0; y < ScreenRaster::kScreenHeight; y++) {
-    for (int x = 0; x < ScreenRaster::kScreenWidth; x++) {
-      raster->Set(y, x, (*screen_buffer_)[(x + x_offset) + (y + y_offset) * kScreenBufferSize]);
-    }
+void GraphicsController::Init(scheduler::Scheduler* scheduler) {
+  // TODO(Brendan): Add the flags from graphics_flags_.
+  add_memory_segment(&vram_segment_);
+  add_memory_segment(&oam_segment_);
+
+  for (auto flag : graphics_flags_.flags()) {
+    add_flag(flag);
   }
 
-  LOG(INFO) << "Rendering screen.";
-  screen->Draw();
+  scheduler_ = scheduler;
+  SetLine(0);
+  EnterOAMLocked(scheduler_->now());
 }
 
-void RenderLowPrioritySprites(GraphicsFlags* graphics_flags, 
-                              OAMSegment* oam_segment, 
-                              VRAMSegment* vram_segment, 
-                              vector<unsigned char>* screen_buffer_) {
-  if (!graphics_flags->lcd_control()->sprite_display_enable()) {
-    return;
-  }
-  // LOG(INFO) << "Rendering low priority sprites.";
-  for (int i = 0; i < OAMSegment::kAttributeNumber; i++) {
-    SpriteAttribute* sprite_attribute = oam_segment->sprite_attribute(i);
-    if (!sprite_attribute->over_background()) {
-      RenderSprite(sprite_attribute, graphics_flags, vram_segment, screen_buffer_);
-    }
-  }
+void GraphicsController::AttachPresenter(Presenter* presenter) {
+  presenter_ = presenter;
+  presenter_->Start(&frames_);
 }
 
-void RenderHighPrioritySprites(GraphicsFlags* graphics_flags, 
-                               OAMSegment* oam_segment, 
-                               VRAMSegment* vram_segment, 
-                               vector<unsigned char>* screen_buffer_) {
-  if (!graphics_flags->lcd_control()->sprite_display_enable()) {
+void GraphicsController::Draw() {
+  frames_.Publish();
+  if (presenter_ != nullptr) {
+    presenter_->FramePublished();
     return;
   }
-  // LOG(INFO) << "Rendering high priority sprites.";
-  for (int i = 0; i < OAMSegment::kAttributeNumber; i++) {
-    SpriteAttribute* sprite_attribute = oam_segment->sprite_attribute(i);
-    if (sprite_attribute->over_background()) {
-      RenderSprite(sprite_attribute, graphics_flags, vram_segment, screen_buffer_);
-    }
-  }
+  // Nothing else consumes frames, so this thread acquires the frame it just
+  // published and draws it itself.
+  frames_.Acquire();
+  DIAGNOSE(1, GRAPHICS, "Rendering screen.");
+  screen_->mutable_raster()->SetFrame(frames_.front_buffer().data());
+  screen_->Draw();
 }
 
-void RenderBackground(GraphicsFlags* graphics_flags, VRAMSegment* vram_segment, vector<unsigned char>* screen_buffer) {
-  LCDControl* lcd_control = graphics_flags->lcd_control();
-  if (!lcd_control->bg_display()) {
-    // Nothing to do if BG display is unset.
-    return;
-  }
-
-  BackgroundMap* background;
-  if (lcd_control->bg_tile_map_display_select()) {
-    background = vram_segment->upper_background_map();
-  } else {
-    background = vram_segment->lower_background_map();
-  }
-
-  TileData* tile_data;
-  if (lcd_control->bg_window_tile_data_select()) {
-    tile_data = vram_segment->lower_tile_data();
-  } else {
-    tile_data = vram_segment->upper_tile_data();
-  }
-
-  for (int y = 0; y < kScreenBufferSize / Tile::kTileSize; y++) {
-    for (int x = 0; x < kScreenBufferSize / Tile::kTileSize; x++) {
-      Tile* tile = tile_data->tile(background->Get(y, x));
-      RenderTile(tile, y * Tile::kTileSize, x * Tile::kTileSize, graphics_flags->background_palette(), screen_buffer);
-    }
+void GraphicsController::RunModeEvent(uint64_t time) {
+  switch (mode_) {
+    case LCDStatus::OAM_LOCKED:
+      EnterVRAMOAMLocked(time);
+      break;
+    case LCDStatus::VRAM_OAM_LOCKED:
+      EnterHBlank(time);
+      break;
+    case LCDStatus::H_BLANK:
+    case LCDStatus::V_BLANK:
+      NextLine(time);
+      break;
   }
 }
 
-void RenderWindow(GraphicsFlags* graphics_flags, VRAMSegment* vram_segment, vector<unsigned char>* screen_buffer) {
-  LCDControl* lcd_control = graphics_flags->lcd_control();
-  int y_offset = graphics_flags->window_y_position()->flag();
-  y_offset += graphics_flags->scroll_y()->flag();
-  int x_offset = graphics_flags->window_x_position()->flag() + 7;
-  x_offset += graphics_flags->scroll_x()->flag();
+void GraphicsController::SetLine(int line) {
+  LCDStatus* lcd_status = graphics_flags_.lcd_status();
+  LYCompare* ly_compare = graphics_flags_.ly_compare();
 
-  if (!lcd_control->window_display_enable()) {
-    return; // Nothing to do if disabled.
+  line_ = line;
+  graphics_flags_.ly_coordinate()->set_flag(line_);
+  lcd_status->set_coincidence_flag(line_ == ly_compare->flag());
+  if (lcd_status->coincidence_flag() && lcd_status->coincidence_interrupt()) {
+    SetLCDSTATInterrupt();
   }
+}
 
-  BackgroundMap* background;
-  if (lcd_control->window_tile_map_display_select()) {
-    background = vram_segment->upper_background_map();
+void GraphicsController::NextLine(uint64_t time) {
+  LYCoordinate* ly_coordinate = graphics_flags_.ly_coordinate();
+  if (ly_coordinate->has_reset()) {
+    ly_coordinate->clear_reset();
+    SetLine(0);
   } else {
-    background = vram_segment->lower_background_map();
+    SetLine((line_ + 1) % kLines);
   }
 
-  TileData* tile_data;
-  if (lcd_control->bg_window_tile_data_select()) {
-    tile_data = vram_segment->upper_tile_data();
+  if (line_ < kVisibleLines) {
+    EnterOAMLocked(time);
+  } else if (line_ == kVisibleLines) {
+    EnterVBlank(time);
   } else {
-    tile_data = vram_segment->lower_tile_data();
-  }
-
-  for (int y = 0; y < (kScreenBufferSize - y_offset) / Tile::kTileSize; y++) {
-    for (int x = 0; x < (kScreenBufferSize - x_offset) / Tile::kTileSize; x++) {
-      Tile* tile = tile_data->tile(background->Get(y, x));
-      RenderTile(tile,
-                 y * Tile::kTileSize + y_offset,
-                 x * Tile::kTileSize + x_offset,
-                 graphics_flags->background_palette(),
-                 screen_buffer);
-    }
+    scheduler_->Schedule(&mode_event_, time + kSmallPeriod);
   }
 }
 
-void Clear(vector<unsigned char>* screen_buffer_) {
-  for (int y = 0; y < kScreenBufferSize; y++) {
-    for (int x = 0; x < kScreenBufferSize; x++) {
-      (*screen_buffer_)[x + y * kScreenBufferSize] = 0;
-    }
+// Mode 2.
+void GraphicsController::EnterOAMLocked(uint64_t time) {
+  SetMode(LCDStatus::OAM_LOCKED);
+  DisableOAM();
+  EnableVRAM();
+  if (graphics_flags_.lcd_status()->oam_interrupt()) {
+    SetLCDSTATInterrupt();
   }
+  scheduler_->Schedule(&mode_event_, time + kOAMLockedUpperBound);
 }
 
-void Draw(GraphicsFlags* graphics_flags, OAMSegment* oam_segment, VRAMSegment* vram_segment, Screen* screen) {
-  vector<unsigned char> screen_buffer(kScreenBufferSize * kScreenBufferSize, 0);
-  LOG(INFO) << "Clearing...";
-  Clear(&screen_buffer);
-  LOG(INFO) << "Rendering rendering low priority sprites...";
-  RenderLowPrioritySprites(graphics_flags, oam_segment, vram_segment, &screen_buffer);
-  LOG(INFO) << "Rendering background...";
-  RenderBackground(graphics_flags, vram_segment, &screen_buffer);
-  LOG(INFO) << "Rendering window...";
-  RenderWindow(graphics_flags, vram_segment, &screen_buffer);
-  LOG(INFO) << "Rendering rendering high priority sprites...";
-  RenderHighPrioritySprites(graphics_flags, oam_segment, vram_segment, &screen_buffer);
-  LOG(INFO) << "Rendering...";
-  WriteToScreen(graphics_flags, screen, &screen_buffer);
-}
-} // namespace
-
-void GraphicsController::Init() {
-  // TODO(Brendan): Add the flags from graphics_flags_.
-  add_memory_segment(&vram_segment_);
-  add_memory_segment(&oam_segment_);
-
-  for (auto flag : graphics_flags_.flags()) {
-    add_flag(flag);
-  }
+// Mode 3.
+void GraphicsController::EnterVRAMOAMLocked(uint64_t time) {
+  SetMode(LCDStatus::VRAM_OAM_LOCKED);
+  DisableOAM();
+  DisableVRAM();
+  scheduler_->Schedule(&mode_event_, time + kVRAMOAMLockedUpperBound - kOAMLockedUpperBound);
 }
 
-void GraphicsController::Tick(unsigned int number_of_cycles) {
-  LCDStatus* lcd_status = graphics_flags_.lcd_status();
-  LYCoordinate* ly_coordinate = graphics_flags_.ly_coordinate();
-  LYCompare* ly_compare = graphics_flags_.ly_compare();
-
-  if (ly_coordinate->flag() == ly_compare->flag()) {
-    lcd_status->set_coincidence_flag(true);
-    if (lcd_status->coincidence_interrupt()) {
-      interrupt_flag()->set_lcd_stat(true);
+// Mode 0. The line is drawn as the PPU finishes with it, so that it sees
+// whatever the registers were set to up until then.
+void GraphicsController::EnterHBlank(uint64_t time) {
+  if (graphics_flags_.lcd_control()->lcd_display_enable()) {
+    if (RenderLine(&graphics_flags_, &oam_segment_, &oam_scan_, &vram_segment_, planes_, line_, window_line_, frames_.back_buffer())) {
+      window_line_++;
     }
   }
-
-  if (ly_coordinate->has_reset()) {
-    time_ = 0;
-    ly_coordinate->clear_reset();
+  SetMode(LCDStatus::H_BLANK);
+  EnableOAM();
+  EnableVRAM();
+  if (graphics_flags_.lcd_status()->h_blank_interrupt()) {
+    SetLCDSTATInterrupt();
   }
+  scheduler_->Schedule(&mode_event_, time + kHBlankUpperBound - kVRAMOAMLockedUpperBound);
+}
 
-  time_ += number_of_cycles;
-  time_ %= kLargePeriod;
-  // Mode 1.
-  if (time_ > kVBlankLowerBound) {
-    lcd_status->set_mode(LCDStatus::V_BLANK);
-    EnableOAM();
-    EnableVRAM();
-    if (previous_mode_ != MODE_1) {
-      SetVBlankInterrupt();
-      if (lcd_status->v_blank_interrupt()) {
-        SetLCDSTATInterrupt();
-      }
-    }
-    previous_mode_ = MODE_1;
-  // Mode 2.
-  } else if (time_ % kSmallPeriod < kOAMLockedUpperBound) {
-    lcd_status->set_mode(LCDStatus::OAM_LOCKED);
-    DisableOAM();
-    EnableVRAM();
-    if (previous_mode_ != MODE_2) {
-      ly_coordinate->Increment();
-      if (lcd_status->oam_interrupt()) {
-        SetLCDSTATInterrupt();
-      }
-    }
-    previous_mode_ = MODE_2;
-  // Mode 3.
-  } else if (time_ % kSmallPeriod < kVRAMOAMLockedUpperBound) {
-    lcd_status->set_mode(LCDStatus::VRAM_OAM_LOCKED);
-    DisableOAM();
-    DisableVRAM();
-    if (graphics_flags_.lcd_control()->lcd_display_enable() 
-        && previous_mode_ != MODE_3
-        && ly_coordinate->flag() == 0) {
-      Draw(&graphics_flags_, &oam_segment_, &vram_segment_, screen_);
-    }
-    previous_mode_ = MODE_3;
-  // Mode 0.
-  } else if (time_ % kSmallPeriod < kHBlankUpperBound) {
-    lcd_status->set_mode(LCDStatus::H_BLANK);
-    EnableOAM();
-    EnableVRAM();
-    if (lcd_status->h_blank_interrupt() && previous_mode_ != MODE_0) {
-      SetLCDSTATInterrupt();
-    }
-    previous_mode_ = MODE_0;
+// Mode 1.
+void GraphicsController::EnterVBlank(uint64_t time) {
+  SetMode(LCDStatus::V_BLANK);
+  EnableOAM();
+  EnableVRAM();
+  SetVBlankInterrupt();
+  if (graphics_flags_.lcd_status()->v_blank_interrupt()) {
+    SetLCDSTATInterrupt();
+  }
+  if (graphics_flags_.lcd_control()->lcd_display_enable()) {
+    Draw();
   }
+  window_line_ = 0;
+  scheduler_->Schedule(&mode_event_, time + kSmallPeriod);
 }
 
 } // namespace graphics
@@ -1,12 +1,18 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_GRAPHICS_CONTROLLER_H_
 #define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_GRAPHICS_CONTROLLER_H_
 
+#include "cc/backend/graphics/framebuffer.h"
 #include "cc/backend/graphics/graphics_flags.h"
+#include "cc/backend/graphics/oam_scan.h"
+#include "cc/backend/graphics/presenter.h"
 #include "cc/backend/graphics/screen.h"
+#include "cc/backend/graphics/tile_map_plane.h"
+#include "cc/backend/graphics/triple_buffer.h"
 #include "cc/backend/graphics/vram_segment.h"
 #include "cc/backend/memory/interrupt/interrupt_flag.h"
 #include "cc/backend/memory/interrupt/primary_flags.h"
 #include "cc/backend/memory/module.h"
+#include "cc/backend/scheduler/scheduler.h"
 
 namespace backend {
 namespace graphics {
@@ -17,33 +23,49 @@ static const int kVBlankLowerBound = kLargePeriod - kSmallPeriod * 10; // Mode 1
 static const int kOAMLockedUpperBound = 80; // Mode 2.
 static const int kVRAMOAMLockedUpperBound = 172 + kOAMLockedUpperBound; // Mode 3.
 static const int kHBlankUpperBound = 204 + kVRAMOAMLockedUpperBound; // Mode 0.
+static const int kVisibleLines = kVBlankLowerBound / kSmallPeriod;
+static const int kLines = kLargePeriod / kSmallPeriod;
 
-static const int kScreenBufferSize = 256; // Square.
+static const int kWindowXOffset = 7;
 
 class GraphicsController : public memory::Module {
  public:
   GraphicsController(Screen* screen, memory::PrimaryFlags* primary_flags) : 
       screen_(screen), primary_flags_(primary_flags) {}
 
-  void Init();
+  void Init(scheduler::Scheduler* scheduler);
 
-  void Tick(unsigned int number_of_cycles);
+  // Hands every frame to presenter, which draws them on its own thread,
+  // instead of drawing them to the screen on the emulation thread. Must be
+  // called before emulation starts, and presenter must outlive it.
+  void AttachPresenter(Presenter* presenter);
 
  private:
-  enum PreviousMode {
-    MODE_0,
-    MODE_1,
-    MODE_2,
-    MODE_3,
-  };
-
   // TODO(Brendan): Finish implementing interrupt_flag.
   GraphicsFlags graphics_flags_;
   memory::VRAMSegment vram_segment_;
   memory::OAMSegment oam_segment_;
+  OAMScan oam_scan_ = OAMScan(&oam_segment_);
+  // Indexed by the tile map select bits of LCDC.
+  TileMapPlane planes_[2] = {
+    TileMapPlane(vram_segment_.lower_background_map(), vram_segment_.tile_cache()),
+    TileMapPlane(vram_segment_.upper_background_map(), vram_segment_.tile_cache()),
+  };
   Screen* screen_;
   memory::PrimaryFlags* primary_flags_;
-  PreviousMode previous_mode_;
+  scheduler::Scheduler* scheduler_;
+  // Each mode change is an event; the LCD registers only change when one runs.
+  scheduler::Event mode_event_ =
+      scheduler::Event([this](uint64_t time) { RunModeEvent(time); }, "ppu");
+  LCDStatus::Mode mode_ = LCDStatus::OAM_LOCKED;
+  int line_ = 0;
+  // The window keeps its own line counter, which only advances on lines the
+  // window is drawn on.
+  int window_line_ = 0;
+  // Frames are rendered into the back buffer a line at a time and then
+  // published at V-Blank.
+  TripleBuffer frames_;
+  Presenter* presenter_ = nullptr;
   memory::InterruptFlag* interrupt_flag() { return primary_flags_->interrupt_flag(); }
 
   void SetLCDSTATInterrupt() { interrupt_flag()->set_lcd_stat(true); }
@@ -52,7 +74,20 @@ class GraphicsController : public memory::Module {
   void EnableOAM() { oam_segment_.Enable(); }
   void DisableVRAM() { vram_segment_.Disable(); }
   void DisableOAM() { oam_segment_.Disable(); }
-  unsigned long time_ = 0;
+
+  // Publishes the back buffer and, without a presenter, draws it.
+  void Draw();
+  void RunModeEvent(uint64_t time);
+  void SetMode(LCDStatus::Mode mode) {
+    mode_ = mode;
+    graphics_flags_.lcd_status()->set_mode(mode);
+  }
+  void SetLine(int line);
+  void NextLine(uint64_t time);
+  void EnterOAMLocked(uint64_t time);
+  void EnterVRAMOAMLocked(uint64_t time);
+  void EnterHBlank(uint64_t time);
+  void EnterVBlank(uint64_t time);
 };
 
 } // namespace graphics
@@ -1,6 +1,7 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_GRAPHICS_FLAGS_H_
 #define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_GRAPHICS_FLAGS_H_
 
+#include "cc/backend/debug/diagnostics.h"
 #include "cc/backend/memory/flags.h"
 #include "cc/backend/memory/memory_segment.h"
 #include "glog/logging.h"
@@ -23,9 +24,9 @@ class LCDControl : public memory::Flag {
   void Write(unsigned short address, unsigned char value) override {
     Flag::Write(address, value);
     if (lcd_display_enable()) {
-      LOG(INFO) << "LCD enabled";
+      DIAGNOSE(1, GRAPHICS, "LCD enabled");
     } else {
-      LOG(INFO) << "LCD disabled";
+      DIAGNOSE(1, GRAPHICS, "LCD disabled");
     }
   }
 };
@@ -83,15 +84,6 @@ class LYCoordinate : public memory::Flag {
 
   void clear_reset() { has_reset_ = false; }
 
-  void Increment() {
-    LOG(INFO) << "LY Coordinate: Increment called, current value = 0x" << std::hex << (0x0000 + flag());
-    if (flag() >= 153) {
-      set_flag(0);
-    } else {
-      set_flag(flag() + 1);
-    }
-  }
-
  private:
   bool has_reset_ = false;
 };
@@ -192,14 +184,14 @@ class GraphicsFlags : public memory::MemorySegment {
     if (lcd_control_.InRange(address)) {
       return lcd_control_.Read(address);
     } else if (lcd_status_.InRange(address)) {
-      LOG(INFO) << "Checked LCD Status.";
+      DIAGNOSE(2, GRAPHICS, "Checked LCD Status.");
       return lcd_status_.Read(address);
     } else if (scroll_y_.InRange(address)) {
       return scroll_y_.Read(address);
     } else if (scroll_x_.InRange(address)) {
       return scroll_x_.Read(address);
     } else if (ly_coordinate_.InRange(address)) {
-      LOG(INFO) << "Checked LY LYCoordinate";
+      DIAGNOSE(2, GRAPHICS, "Checked LY LYCoordinate");
       return ly_coordinate_.Read(address);
     } else if (ly_compare_.InRange(address)) {
       return ly_compare_.Read(address);
@@ -221,48 +213,36 @@ class GraphicsFlags : public memory::MemorySegment {
   virtual void Write(unsigned short address, unsigned char value) {
     if (lcd_control_.InRange(address)) {
       lcd_control_.Write(address, value);
-      LOG(INFO) << "LCD control written to.";
-      LOG(INFO) << "lcd_control = " << lcd_control_.lcd_display_enable();
-      LOG(INFO) << "window_tile_map_display_select = " << lcd_control_.window_tile_map_display_select();
-      LOG(INFO) << "window_display_enable = " << lcd_control_.window_display_enable();
-      LOG(INFO) << "bg_window_tile_data_select = " << lcd_control_.bg_window_tile_data_select();
-      LOG(INFO) << "bg_tile_map_display_select = " << lcd_control_.bg_tile_map_display_select();
-      LOG(INFO) << "sprite_size = " << lcd_control_.sprite_size();
-      LOG(INFO) << "sprite_display_enable = " << lcd_control_.sprite_display_enable();
-      LOG(INFO) << "bg_display = " << lcd_control_.bg_display();
+      DIAGNOSE(1, GRAPHICS, "LCD control written to, 0x%x.", value);
     } else if (lcd_status_.InRange(address)) {
       lcd_status_.Write(address, value);
-      LOG(INFO) << "LCD status written to.";
-      LOG(INFO) << "coincidence_interrupt = " << lcd_status_.coincidence_interrupt();
-      LOG(INFO) << "oam_interrupt = " << lcd_status_.oam_interrupt();
-      LOG(INFO) << "v_blank_interrupt = " << lcd_status_.v_blank_interrupt();
-      LOG(INFO) << "h_blank_interrupt = " << lcd_status_.h_blank_interrupt();
+      DIAGNOSE(1, GRAPHICS, "LCD status written to, 0x%x.", value);
     } else if (scroll_y_.InRange(address)) {
       scroll_y_.Write(address, value);
-      LOG(INFO) << "Scroll Y written to.";
+      DIAGNOSE(1, GRAPHICS, "Scroll Y written to, %d.", value);
     } else if (scroll_x_.InRange(address)) {
       scroll_x_.Write(address, value);
-      LOG(INFO) << "Scroll X written to.";
+      DIAGNOSE(1, GRAPHICS, "Scroll X written to, %d.", value);
     } else if (ly_coordinate_.InRange(address)) {
       ly_coordinate_.Write(address, value);
     } else if (ly_compare_.InRange(address)) {
       ly_compare_.Write(address, value);
-      LOG(INFO) << "LY Compare written to, value = " << value;
+      DIAGNOSE(1, GRAPHICS, "LY Compare written to, %d.", value);
     } else if (window_y_position_.InRange(address)) {
       window_y_position_.Write(address, value);
-      LOG(INFO) << "Window Y Position set.";
+      DIAGNOSE(1, GRAPHICS, "Window Y Position set to %d.", value);
     } else if (window_x_position_.InRange(address)) {
-      LOG(INFO) << "Window X Position set.";
+      DIAGNOSE(1, GRAPHICS, "Window X Position set to %d.", value);
       window_x_position_.Write(address, value);
     } else if (background_palette_.InRange(address)) {
       background_palette_.Write(address, value);
-      LOG(INFO) << std::hex << 0x0000 + value << " was written to the background palette";
+      DIAGNOSE(1, GRAPHICS, "0x%x was written to the background palette", value);
     } else if (object_palette_0_.InRange(address)) {
       object_palette_0_.Write(address, value);
-      LOG(INFO) << std::hex << 0x0000 + value << " was written to the object palette 0 palette";
+      DIAGNOSE(1, GRAPHICS, "0x%x was written to the object palette 0 palette", value);
     } else if (object_palette_1_.InRange(address)) {
       object_palette_1_.Write(address, value);
-      LOG(INFO) << std::hex << 0x0000 + value << " was written to the object palette 1 palette";
+      DIAGNOSE(1, GRAPHICS, "0x%x was written to the object palette 1 palette", value);
     } else {
       LOG(FATAL) << "Address outside of range: " << address;
     }
@@ -0,0 +1,54 @@
+#include "cc/backend/graphics/oam_scan.h"
+
+#include <algorithm>
+
+namespace backend {
+namespace graphics {
+
+using memory::OAMSegment;
+using memory::SpriteAttribute;
+
+const int OAMScan::kSpritesPerLine;
+const int OAMScan::kLineNumber;
+
+void OAMScan::Update(int sprite_height) {
+  if (oam_segment_->has_changed() || sprite_height != sprite_height_) {
+    oam_segment_->clear_changed();
+    sprite_height_ = sprite_height;
+    Scan();
+  }
+}
+
+void OAMScan::Scan() {
+  unsigned char xs[OAMSegment::kAttributeNumber];
+  int tops[OAMSegment::kAttributeNumber];
+  for (int i = 0; i < OAMSegment::kAttributeNumber; i++) {
+    SpriteAttribute* sprite_attribute = oam_segment_->sprite_attribute(i);
+    xs[i] = sprite_attribute->x();
+    tops[i] = sprite_attribute->y() - kSpriteYOffset;
+  }
+
+  std::fill(sprite_numbers_, sprite_numbers_ + kLineNumber, 0);
+  for (int i = 0; i < OAMSegment::kAttributeNumber; i++) {
+    const int bottom = std::min(tops[i] + sprite_height_, kLineNumber);
+    for (int y = std::max(tops[i], 0); y < bottom; y++) {
+      int& sprite_number = sprite_numbers_[y];
+      if (sprite_number == kSpritesPerLine) {
+        continue;
+      }
+      // Sprites are scanned in OAM order, so one only goes ahead of the
+      // sprites already on the line with a strictly smaller x.
+      unsigned char* sprites = sprites_[y];
+      int position = sprite_number;
+      while (position > 0 && xs[sprites[position - 1]] > xs[i]) {
+        sprites[position] = sprites[position - 1];
+        position--;
+      }
+      sprites[position] = i;
+      sprite_number++;
+    }
+  }
+}
+
+} // namespace graphics
+} // namespace backend
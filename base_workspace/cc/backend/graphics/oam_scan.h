@@ -0,0 +1,49 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_OAM_SCAN_H_
+#define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_OAM_SCAN_H_
+
+#include "cc/backend/graphics/screen.h"
+#include "cc/backend/graphics/vram_segment.h"
+
+namespace backend {
+namespace graphics {
+
+// OAM holds the position of the bottom right corner of a 16x16 sprite, so that
+// a sprite can be partially off the top left of the screen.
+static const int kSpriteYOffset = 16;
+static const int kSpriteXOffset = 8;
+
+// The sprites on each line of the screen, found the way the PPU does in
+// mode 2: the first kSpritesPerLine sprites in OAM which cross a line are the
+// only ones drawn on it. Each line's sprites are sorted by x and then by OAM
+// index, which is the order in which the hardware gives them priority. The
+// lines are only found again after OAM or the sprite height has changed.
+class OAMScan {
+ public:
+  static const int kSpritesPerLine = 10;
+  static const int kLineNumber = ScreenRaster::kScreenHeight;
+
+  explicit OAMScan(memory::OAMSegment* oam_segment) : oam_segment_(oam_segment) {}
+
+  // Scans OAM again if it has been written since the last scan, or if the
+  // sprites are now sprite_height, 8 or 16, lines tall.
+  void Update(int sprite_height);
+
+  // The number of sprites on line y.
+  int sprite_number(int y) const { return sprite_numbers_[y]; }
+
+  // The OAM indices of the sprites on line y, highest priority first.
+  const unsigned char* sprites(int y) const { return sprites_[y]; }
+
+ private:
+  void Scan();
+
+  memory::OAMSegment* oam_segment_;
+  int sprite_height_ = 0;
+  int sprite_numbers_[kLineNumber];
+  unsigned char sprites_[kLineNumber][kSpritesPerLine];
+};
+
+} // namespace graphics
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_GRAPHICS_OAM_SCAN_H_
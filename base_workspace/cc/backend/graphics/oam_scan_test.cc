@@ -0,0 +1,72 @@
+#include "cc/backend/graphics/oam_scan.h"
+
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace graphics {
+
+using memory::OAMSegment;
+
+namespace {
+
+// Places sprite index with its top left corner at (y, x) on the screen.
+void Place(OAMSegment* oam_segment, int index, int y, int x) {
+  oam_segment->Write(OAMSegment::kStartAddress + index * 4, y + kSpriteYOffset);
+  oam_segment->Write(OAMSegment::kStartAddress + index * 4 + 1, x + kSpriteXOffset);
+}
+
+} // namespace
+
+TEST(OAMScanTest, KeepsTheFirstTenSpritesOfEachLineSortedByX) {
+  OAMSegment oam_segment;
+  for (int i = 0; i < 12; i++) {
+    Place(&oam_segment, i, 20, 100 - i * 8);
+  }
+  // Same x as sprite 1, but later in OAM.
+  Place(&oam_segment, 12, 0, 92);
+  Place(&oam_segment, 13, 0, 120);
+  Place(&oam_segment, 1, 0, 92);
+
+  OAMScan oam_scan(&oam_segment);
+  oam_scan.Update(8);
+
+  // Sprite 11 is past the limit, even though it is leftmost.
+  const unsigned char expected[] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 0};
+  ASSERT_EQ(10, oam_scan.sprite_number(20));
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(expected[i], oam_scan.sprites(20)[i]) << i;
+  }
+  EXPECT_EQ(3, oam_scan.sprite_number(7));
+  EXPECT_EQ(1, oam_scan.sprites(7)[0]);
+  EXPECT_EQ(12, oam_scan.sprites(7)[1]);
+  EXPECT_EQ(13, oam_scan.sprites(7)[2]);
+  EXPECT_EQ(0, oam_scan.sprite_number(8));
+}
+
+TEST(OAMScanTest, ScansAgainOnlyAfterAChange) {
+  OAMSegment oam_segment;
+  Place(&oam_segment, 0, 100, 50);
+  OAMScan oam_scan(&oam_segment);
+  oam_scan.Update(8);
+  EXPECT_EQ(0, oam_scan.sprite_number(108));
+
+  // Tall sprites reach one tile further down.
+  oam_scan.Update(16);
+  EXPECT_EQ(1, oam_scan.sprite_number(108));
+  EXPECT_EQ(0, oam_scan.sprite_number(116));
+
+  Place(&oam_segment, 0, 110, 50);
+  EXPECT_TRUE(oam_segment.has_changed());
+  oam_scan.Update(16);
+  EXPECT_FALSE(oam_segment.has_changed());
+  EXPECT_EQ(0, oam_scan.sprite_number(100));
+  EXPECT_EQ(1, oam_scan.sprite_number(125));
+
+  // A DMA copies straight into OAM's storage.
+  oam_segment.storage(OAMSegment::kStartAddress)[0] = 0;
+  oam_scan.Update(16);
+  EXPECT_EQ(0, oam_scan.sprite_number(125));
+}
+
+} // namespace graphics
+} // namespace backend
@@ -0,0 +1,212 @@
+#include "cc/backend/graphics/pixel_kernels.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TURBO_SANTA_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace backend {
+namespace graphics {
+
+using std::vector;
+
+namespace {
+
+void DecodeRowScalar(uint8_t low, uint8_t high, uint8_t* indices) {
+  for (int x = 0; x < 8; x++) {
+    const int bit = 7 - x;
+    indices[x] = ((low >> bit) & 0b00000001) | (((high >> bit) & 0b00000001) << 1);
+  }
+}
+
+void MapShadesScalar(const uint8_t* indices, int width, const uint8_t* shades, uint8_t* out) {
+  for (int i = 0; i < width; i++) {
+    out[i] = shades[indices[i]];
+  }
+}
+
+void MapSpriteShadesScalar(const uint8_t* colors,
+                           const uint8_t* background,
+                           int width,
+                           bool behind_background,
+                           const uint8_t* shades,
+                           uint8_t* out) {
+  for (int i = 0; i < width; i++) {
+    if (colors[i] != 0 && (!behind_background || background[i] == 0)) {
+      out[i] = shades[colors[i]];
+    }
+  }
+}
+
+#ifdef TURBO_SANTA_X86_KERNELS
+
+// The vectorized kernels are compiled for their instruction set regardless of
+// the flags the rest of the tree is built with, and only run once the CPU is
+// known to support it.
+#define SSE2 __attribute__((target("sse2")))
+#define SSSE3 __attribute__((target("ssse3")))
+#define AVX2 __attribute__((target("avx2")))
+
+// A byte for each pixel of a bitplane, leftmost first, which is 0xff if the
+// pixel's bit is set.
+SSE2 __m128i SpreadBits(uint8_t bitplane) {
+  const __m128i bits = _mm_set_epi8(0, 0, 0, 0, 0, 0, 0, 0,
+                                    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80));
+  return _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8(bitplane), bits), bits);
+}
+
+SSE2 void DecodeRowSSE2(uint8_t low, uint8_t high, uint8_t* indices) {
+  const __m128i low_bits = _mm_and_si128(SpreadBits(low), _mm_set1_epi8(1));
+  const __m128i high_bits = _mm_and_si128(SpreadBits(high), _mm_set1_epi8(2));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(indices), _mm_or_si128(low_bits, high_bits));
+}
+
+// Without a byte shuffle each of the three other shades is selected where the
+// index matches it.
+SSE2 __m128i ShadeSSE2(__m128i indices, const uint8_t* shades) {
+  __m128i shaded = _mm_set1_epi8(shades[0]);
+  for (int color = 1; color < 4; color++) {
+    const __m128i is_color = _mm_cmpeq_epi8(indices, _mm_set1_epi8(color));
+    shaded = _mm_or_si128(_mm_andnot_si128(is_color, shaded),
+                          _mm_and_si128(is_color, _mm_set1_epi8(shades[color])));
+  }
+  return shaded;
+}
+
+// The four shades in the low bytes of a register, for looking up with a byte
+// shuffle.
+SSE2 __m128i ShadeTable(const uint8_t* shades) {
+  int32_t table;
+  memcpy(&table, shades, sizeof(table));
+  return _mm_cvtsi32_si128(table);
+}
+
+SSSE3 __m128i ShadeSSSE3(__m128i indices, const uint8_t* shades) {
+  return _mm_shuffle_epi8(ShadeTable(shades), indices);
+}
+
+// Keeps the shade wherever the sprite is drawn and what is already in out
+// everywhere else; only the low eight bytes are meaningful.
+SSE2 __m128i BlendSprite(__m128i colors, __m128i background, bool behind_background, __m128i shaded, __m128i out) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i hidden = _mm_cmpeq_epi8(colors, zero);
+  if (behind_background) {
+    hidden = _mm_or_si128(hidden, _mm_xor_si128(_mm_cmpeq_epi8(background, zero), _mm_set1_epi8(-1)));
+  }
+  return _mm_or_si128(_mm_and_si128(hidden, out), _mm_andnot_si128(hidden, shaded));
+}
+
+SSE2 void MapShadesSSE2(const uint8_t* indices, int width, const uint8_t* shades, uint8_t* out) {
+  int i = 0;
+  for (; i + 16 <= width; i += 16) {
+    const __m128i shaded = ShadeSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)), shades);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), shaded);
+  }
+  MapShadesScalar(indices + i, width - i, shades, out + i);
+}
+
+SSE2 void MapSpriteShadesSSE2(const uint8_t* colors,
+                              const uint8_t* background,
+                              int width,
+                              bool behind_background,
+                              const uint8_t* shades,
+                              uint8_t* out) {
+  int i = 0;
+  for (; i + 8 <= width; i += 8) {
+    const __m128i sprite = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(colors + i));
+    const __m128i blended = BlendSprite(sprite,
+                                        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(background + i)),
+                                        behind_background,
+                                        ShadeSSE2(sprite, shades),
+                                        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(out + i)));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), blended);
+  }
+  MapSpriteShadesScalar(colors + i, background + i, width - i, behind_background, shades, out + i);
+}
+
+SSSE3 void MapShadesSSSE3(const uint8_t* indices, int width, const uint8_t* shades, uint8_t* out) {
+  const __m128i table = ShadeTable(shades);
+  int i = 0;
+  for (; i + 16 <= width; i += 16) {
+    const __m128i shaded = _mm_shuffle_epi8(table, _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), shaded);
+  }
+  MapShadesScalar(indices + i, width - i, shades, out + i);
+}
+
+SSSE3 void MapSpriteShadesSSSE3(const uint8_t* colors,
+                                const uint8_t* background,
+                                int width,
+                                bool behind_background,
+                                const uint8_t* shades,
+                                uint8_t* out) {
+  int i = 0;
+  for (; i + 8 <= width; i += 8) {
+    const __m128i sprite = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(colors + i));
+    const __m128i blended = BlendSprite(sprite,
+                                        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(background + i)),
+                                        behind_background,
+                                        ShadeSSSE3(sprite, shades),
+                                        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(out + i)));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), blended);
+  }
+  MapSpriteShadesScalar(colors + i, background + i, width - i, behind_background, shades, out + i);
+}
+
+// The shuffle works within each 128 bit lane, so both lanes get the table.
+AVX2 void MapShadesAVX2(const uint8_t* indices, int width, const uint8_t* shades, uint8_t* out) {
+  const __m256i table = _mm256_broadcastsi128_si256(ShadeTable(shades));
+  int i = 0;
+  for (; i + 32 <= width; i += 32) {
+    const __m256i shaded = _mm256_shuffle_epi8(table, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), shaded);
+  }
+  // The rest is done by SSE code, which is slow to run while the upper halves
+  // of the AVX registers are dirty.
+  _mm256_zeroupper();
+  MapShadesSSSE3(indices + i, width - i, shades, out + i);
+}
+
+#endif // TURBO_SANTA_X86_KERNELS
+
+const PixelKernels kScalarKernels = {"scalar", DecodeRowScalar, MapShadesScalar, MapSpriteShadesScalar};
+
+#ifdef TURBO_SANTA_X86_KERNELS
+const PixelKernels kSSE2Kernels = {"sse2", DecodeRowSSE2, MapShadesSSE2, MapSpriteShadesSSE2};
+const PixelKernels kSSSE3Kernels = {"ssse3", DecodeRowSSE2, MapShadesSSSE3, MapSpriteShadesSSSE3};
+// Sprites are at most eight pixels wide, which AVX2 is no better at.
+const PixelKernels kAVX2Kernels = {"avx2", DecodeRowSSE2, MapShadesAVX2, MapSpriteShadesSSSE3};
+#endif // TURBO_SANTA_X86_KERNELS
+
+} // namespace
+
+const PixelKernels& ScalarKernels() {
+  return kScalarKernels;
+}
+
+const PixelKernels& Kernels() {
+  static const PixelKernels* kernels = SupportedKernels().back();
+  return *kernels;
+}
+
+vector<const PixelKernels*> SupportedKernels() {
+  vector<const PixelKernels*> kernels = {&kScalarKernels};
+#ifdef TURBO_SANTA_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2")) {
+    kernels.push_back(&kSSE2Kernels);
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    kernels.push_back(&kSSSE3Kernels);
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    kernels.push_back(&kAVX2Kernels);
+  }
+#endif // TURBO_SANTA_X86_KERNELS
+  return kernels;
+}
+
+} // namespace graphics
+} // namespace backend
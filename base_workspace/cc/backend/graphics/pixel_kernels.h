@@ -0,0 +1,48 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_PIXEL_KERNELS_H_
+#define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_PIXEL_KERNELS_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace backend {
+namespace graphics {
+
+// The inner loops of rendering: turning tile data into color indices and
+// color indices into shades. Every set of kernels computes exactly what the
+// scalar set does; on x86 there are vectorized sets as well, and Kernels()
+// picks the fastest one the CPU supports the first time it is called.
+struct PixelKernels {
+  const char* name;
+
+  // Expands one row of a tile, given as its low and high bitplane bytes, into
+  // eight color indices, leftmost pixel first.
+  void (*decode_row)(uint8_t low, uint8_t high, uint8_t* indices);
+
+  // Sets out[i] to shades[indices[i]] for every i < width; shades holds the
+  // shade of each of the four color indices.
+  void (*map_shades)(const uint8_t* indices, int width, const uint8_t* shades, uint8_t* out);
+
+  // Like map_shades, but for a sprite: color 0 is transparent and, if
+  // behind_background is set, so is every pixel whose background color
+  // index, in background, is not 0.
+  void (*map_sprite_shades)(const uint8_t* colors,
+                            const uint8_t* background,
+                            int width,
+                            bool behind_background,
+                            const uint8_t* shades,
+                            uint8_t* out);
+};
+
+const PixelKernels& ScalarKernels();
+
+// The fastest kernels this CPU supports.
+const PixelKernels& Kernels();
+
+// Every set of kernels this CPU supports, slowest, which is the scalar set,
+// first.
+std::vector<const PixelKernels*> SupportedKernels();
+
+} // namespace graphics
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_GRAPHICS_PIXEL_KERNELS_H_
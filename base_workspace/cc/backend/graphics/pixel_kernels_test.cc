@@ -0,0 +1,71 @@
+#include "cc/backend/graphics/pixel_kernels.h"
+
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace graphics {
+
+using std::vector;
+
+namespace {
+
+vector<uint8_t> RandomIndices(int size) {
+  vector<uint8_t> indices(size);
+  for (uint8_t& index : indices) {
+    index = rand() % 4;
+  }
+  return indices;
+}
+
+} // namespace
+
+TEST(PixelKernelsTest, DecodesLeftmostPixelFromBit7) {
+  uint8_t indices[8];
+  ScalarKernels().decode_row(0b10100000, 0b11000001, indices);
+  const uint8_t expected[8] = {3, 2, 1, 0, 0, 0, 0, 2};
+  for (int x = 0; x < 8; x++) {
+    EXPECT_EQ(expected[x], indices[x]) << x;
+  }
+}
+
+TEST(PixelKernelsTest, EveryKernelMatchesScalar) {
+  const PixelKernels& scalar = ScalarKernels();
+  const uint8_t shades[4] = {0, 64, 128, 192};
+  for (const PixelKernels* kernels : SupportedKernels()) {
+    SCOPED_TRACE(kernels->name);
+    for (int low = 0; low < 256; low++) {
+      for (int high = 0; high < 256; high += 17) {
+        uint8_t expected[8];
+        uint8_t actual[8];
+        scalar.decode_row(low, high, expected);
+        kernels->decode_row(low, high, actual);
+        ASSERT_EQ(vector<uint8_t>(expected, expected + 8), vector<uint8_t>(actual, actual + 8));
+      }
+    }
+
+    // Widths which leave every kind of remainder after the vector loops.
+    for (int width : {1, 7, 8, 15, 16, 33, 160}) {
+      const vector<uint8_t> indices = RandomIndices(width);
+      const vector<uint8_t> background = RandomIndices(width);
+      vector<uint8_t> expected(width, 0xaa);
+      vector<uint8_t> actual(width, 0xaa);
+      scalar.map_shades(indices.data(), width, shades, expected.data());
+      kernels->map_shades(indices.data(), width, shades, actual.data());
+      EXPECT_EQ(expected, actual) << width;
+
+      for (bool behind_background : {false, true}) {
+        vector<uint8_t> expected(width, 0xaa);
+        vector<uint8_t> actual(width, 0xaa);
+        scalar.map_sprite_shades(indices.data(), background.data(), width, behind_background, shades, expected.data());
+        kernels->map_sprite_shades(indices.data(), background.data(), width, behind_background, shades, actual.data());
+        EXPECT_EQ(expected, actual) << width << " " << behind_background;
+      }
+    }
+  }
+}
+
+} // namespace graphics
+} // namespace backend
@@ -0,0 +1,45 @@
+#include "cc/backend/graphics/presenter.h"
+
+#include <chrono>
+
+#include "cc/backend/debug/diagnostics.h"
+
+namespace backend {
+namespace graphics {
+
+namespace {
+
+// About a quarter of a frame.
+const std::chrono::milliseconds kMaxWait(4);
+
+} // namespace
+
+void Presenter::Start(TripleBuffer* frames) {
+  frames_ = frames;
+  is_running_ = true;
+  thread_ = std::thread(&Presenter::PresentationLoop, this);
+}
+
+void Presenter::Stop() {
+  is_running_ = false;
+  frame_condition_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void Presenter::PresentationLoop() {
+  while (is_running_) {
+    if (frames_->Acquire()) {
+      DIAGNOSE(1, GRAPHICS, "Rendering screen.");
+      screen_->mutable_raster()->SetFrame(frames_->front_buffer().data());
+      screen_->Draw();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(frame_mutex_);
+    frame_condition_.wait_for(lock, kMaxWait);
+  }
+}
+
+} // namespace graphics
+} // namespace backend
@@ -0,0 +1,52 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_PRESENTER_H_
+#define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_PRESENTER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "cc/backend/graphics/screen.h"
+#include "cc/backend/graphics/triple_buffer.h"
+
+namespace backend {
+namespace graphics {
+
+// Draws frames to a Screen on a thread of its own, so that however long the
+// Screen takes the emulation thread never waits on it. Owned by the frontend
+// and attached to the GraphicsController, which then only publishes frames.
+// The Presenter draws the newest frame each time it wakes, skipping any
+// published in the meantime.
+class Presenter {
+ public:
+  Presenter(Screen* screen) : screen_(screen), is_running_(false) {}
+  ~Presenter() { Stop(); }
+
+  // Starts drawing the frames published to frames.
+  void Start(TripleBuffer* frames);
+
+  // Stops drawing and waits for the frame being drawn, if any, to finish.
+  void Stop();
+
+  // Called by the producer after it publishes a frame; never blocks.
+  void FramePublished() { frame_condition_.notify_one(); }
+
+ private:
+  Screen* screen_;
+  TripleBuffer* frames_ = nullptr;
+  std::atomic<bool> is_running_;
+  // FramePublished() does not take frame_mutex_, so a notification which
+  // lands between the PresentationLoop checking for a frame and going to
+  // sleep is missed; the loop never sleeps longer than kMaxWait for that
+  // reason.
+  std::mutex frame_mutex_;
+  std::condition_variable frame_condition_;
+  std::thread thread_;
+
+  void PresentationLoop();
+};
+
+} // namespace graphics
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_GRAPHICS_PRESENTER_H_
@@ -1,6 +1,8 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_SCREEN_H_
 #define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_SCREEN_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include "glog/logging.h"
 
@@ -16,6 +18,16 @@ class ScreenRaster {
 
   virtual void Set(uint32_t y, uint32_t x, uint8_t value) = 0;
 
+  // Replaces the whole raster with a row major kScreenWidth x kScreenHeight
+  // frame.
+  virtual void SetFrame(const uint8_t* frame) {
+    for (int y = 0; y < kScreenHeight; y++) {
+      for (int x = 0; x < kScreenWidth; x++) {
+        Set(y, x, frame[x + kScreenWidth * y]);
+      }
+    }
+  }
+
  protected:
   void Check(unsigned int y, unsigned int x) const {
     if (y >= kScreenHeight || x >= kScreenWidth) {
@@ -38,6 +50,10 @@ class DefaultRaster : public ScreenRaster {
     data_[x + kScreenWidth * y] = value;
   }
 
+  void SetFrame(const uint8_t* frame) override {
+    std::copy(frame, frame + kScreenWidth * kScreenHeight, data_.begin());
+  }
+
   static const int kScreenHeight = 144;
   static const int kScreenWidth = 160;
   
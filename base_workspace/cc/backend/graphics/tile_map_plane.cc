@@ -0,0 +1,55 @@
+#include "cc/backend/graphics/tile_map_plane.h"
+
+#include <cstring>
+
+namespace backend {
+namespace graphics {
+
+using memory::BackgroundMap;
+using memory::TileCache;
+using memory::TileData;
+
+const int TileMapPlane::kSize;
+
+TileMapPlane::TileMapPlane(BackgroundMap* background, TileCache* tile_cache) :
+    background_(background),
+    tile_cache_(tile_cache),
+    pixels_(kSize * kSize, 0x00),
+    tiles_(BackgroundMap::kWidth * BackgroundMap::kHeight, -1),
+    tile_versions_(BackgroundMap::kWidth * BackgroundMap::kHeight, 0),
+    rows_(BackgroundMap::kHeight) {}
+
+const unsigned char* TileMapPlane::line(int y, TileData* tile_data) {
+  const int map_y = y / TileCache::kTileSize;
+  const RowState& row = rows_[map_y];
+  if (row.tile_data != tile_data ||
+      row.background_version != background_->version() ||
+      row.tile_cache_version != tile_cache_->version()) {
+    Refresh(map_y, tile_data);
+  }
+  return pixels_.data() + y * kSize;
+}
+
+void TileMapPlane::Refresh(int map_y, TileData* tile_data) {
+  for (int map_x = 0; map_x < BackgroundMap::kWidth; map_x++) {
+    const int entry = map_x + map_y * BackgroundMap::kWidth;
+    const int tile = tile_data->tile_index(background_->Get(map_y, map_x));
+    if (tile == tiles_[entry] && tile_cache_->version(tile) == tile_versions_[entry]) {
+      continue;
+    }
+    tiles_[entry] = tile;
+    tile_versions_[entry] = tile_cache_->version(tile);
+    unsigned char* pixels = pixels_.data() + map_y * TileCache::kTileSize * kSize + map_x * TileCache::kTileSize;
+    for (int tile_y = 0; tile_y < TileCache::kTileSize; tile_y++) {
+      memcpy(pixels + tile_y * kSize, tile_cache_->row(tile, tile_y, false), TileCache::kTileSize);
+    }
+  }
+
+  RowState& row = rows_[map_y];
+  row.tile_data = tile_data;
+  row.background_version = background_->version();
+  row.tile_cache_version = tile_cache_->version();
+}
+
+} // namespace graphics
+} // namespace backend
@@ -0,0 +1,50 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_TILE_MAP_PLANE_H_
+#define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_TILE_MAP_PLANE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "cc/backend/graphics/vram_segment.h"
+
+namespace backend {
+namespace graphics {
+
+// The 256x256 plane of color indices a BackgroundMap describes, kept drawn so
+// that the background and window are copied out of it a line at a time. A
+// tile of the plane is only drawn again once its map entry, the tile it refers
+// to or the tile data select has changed; a row of tiles in which nothing has
+// changed costs three comparisons.
+class TileMapPlane {
+ public:
+  static const int kSize = memory::BackgroundMap::kWidth * memory::TileCache::kTileSize;
+
+  TileMapPlane(memory::BackgroundMap* background, memory::TileCache* tile_cache);
+
+  // The color indices of line y of the plane, with the tiles looked up in
+  // tile_data.
+  const unsigned char* line(int y, memory::TileData* tile_data);
+
+ private:
+  // Draws any tiles of row map_y of the map which are out of date.
+  void Refresh(int map_y, memory::TileData* tile_data);
+
+  memory::BackgroundMap* background_;
+  memory::TileCache* tile_cache_;
+  std::vector<unsigned char> pixels_;
+  // The TileCache index and version of the tile drawn for each map entry.
+  std::vector<int> tiles_;
+  std::vector<uint32_t> tile_versions_;
+
+  // What each row of the map was last brought up to date with.
+  struct RowState {
+    uint32_t background_version = 0;
+    uint32_t tile_cache_version = 0;
+    memory::TileData* tile_data = nullptr;
+  };
+  std::vector<RowState> rows_;
+};
+
+} // namespace graphics
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_GRAPHICS_TILE_MAP_PLANE_H_
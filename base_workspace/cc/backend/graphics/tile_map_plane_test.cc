@@ -0,0 +1,37 @@
+#include "cc/backend/graphics/tile_map_plane.h"
+
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace graphics {
+
+using memory::VRAMSegment;
+
+TEST(TileMapPlaneTest, RedrawsTilesWhoseEntryDataOrSelectChanged) {
+  VRAMSegment vram_segment;
+  TileMapPlane plane(vram_segment.lower_background_map(), vram_segment.tile_cache());
+  // Tile 1 has color 1 in its leftmost pixel on every row; the lower tile
+  // data holds it at 0x8010 and the upper tile data at 0x9010.
+  for (int y = 0; y < 8; y++) {
+    vram_segment.Write(0x8010 + y * 2, 0x80);
+    vram_segment.Write(0x9010 + y * 2 + 1, 0x80);
+  }
+
+  EXPECT_EQ(0, plane.line(8, vram_segment.lower_tile_data())[16]);
+
+  // Map entry (1, 2) now refers to tile 1.
+  vram_segment.Write(0x9800 + 32 + 2, 0x01);
+  EXPECT_EQ(1, plane.line(8, vram_segment.lower_tile_data())[16]);
+  EXPECT_EQ(0, plane.line(8, vram_segment.lower_tile_data())[17]);
+
+  // The other tile data holds a different tile 1.
+  EXPECT_EQ(2, plane.line(15, vram_segment.upper_tile_data())[16]);
+
+  vram_segment.Write(0x901f, 0x40);
+  EXPECT_EQ(0, plane.line(15, vram_segment.upper_tile_data())[16]);
+  EXPECT_EQ(2, plane.line(15, vram_segment.upper_tile_data())[17]);
+  EXPECT_EQ(2, plane.line(14, vram_segment.upper_tile_data())[16]);
+}
+
+} // namespace graphics
+} // namespace backend
@@ -0,0 +1,59 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_GRAPHICS_TRIPLE_BUFFER_H_
+#define TURBO_SANTA_COMMON_BACK_END_GRAPHICS_TRIPLE_BUFFER_H_
+
+#include <atomic>
+
+#include "cc/backend/graphics/framebuffer.h"
+
+namespace backend {
+namespace graphics {
+
+// Hands completed frames from the emulation thread, which renders into the back
+// buffer, to a presentation thread, which reads the front buffer, without
+// either ever waiting on the other. The third buffer sits between them and
+// always holds the newest published frame; publishing and acquiring each
+// swap their own buffer with it in a single atomic exchange, so a frame is
+// never read while it is being drawn and a slow presenter only ever skips to
+// the freshest frame.
+class TripleBuffer {
+ public:
+  TripleBuffer() : back_(0), middle_(1), front_(2) {}
+
+  // Producer side. The buffer the next frame is rendered into.
+  Framebuffer* back_buffer() { return &buffers_[back_]; }
+
+  // Producer side. Makes the back buffer the newest frame and takes the
+  // buffer it replaces, which is no longer being read, as the new back buffer.
+  void Publish() {
+    back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndex;
+  }
+
+  // Consumer side. Makes the newest frame the front buffer, if one has been
+  // published since the last call, and returns whether it did.
+  bool Acquire() {
+    if ((middle_.load(std::memory_order_relaxed) & kFresh) == 0) {
+      return false;
+    }
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+    return true;
+  }
+
+  // Consumer side. The last acquired frame.
+  const Framebuffer& front_buffer() const { return buffers_[front_]; }
+
+ private:
+  // middle_ holds a buffer index and, in kFresh, whether that buffer has been
+  // published but not yet acquired.
+  static const int kIndex = 0b011;
+  static const int kFresh = 0b100;
+
+  Framebuffer buffers_[3];
+  int back_;
+  std::atomic<int> middle_;
+  int front_;
+};
+
+} // namespace graphics
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_GRAPHICS_TRIPLE_BUFFER_H_
@@ -0,0 +1,79 @@
+#include "cc/backend/graphics/triple_buffer.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace graphics {
+
+namespace {
+
+// Fills a frame with value, a row at a time.
+void DrawFrame(Framebuffer* frame, uint8_t value) {
+  for (int y = 0; y < Framebuffer::kHeight; y++) {
+    for (int x = 0; x < Framebuffer::kWidth; x++) {
+      frame->Set(y, x, value);
+    }
+  }
+}
+
+} // namespace
+
+TEST(TripleBufferTest, AcquiresOnlyTheNewestFrame) {
+  TripleBuffer frames;
+  EXPECT_FALSE(frames.Acquire());
+
+  DrawFrame(frames.back_buffer(), 1);
+  frames.Publish();
+  DrawFrame(frames.back_buffer(), 2);
+  frames.Publish();
+
+  ASSERT_TRUE(frames.Acquire());
+  EXPECT_EQ(2, frames.front_buffer().Get(0, 0));
+  EXPECT_FALSE(frames.Acquire());
+
+  // Publishing never hands out the buffer being read.
+  DrawFrame(frames.back_buffer(), 3);
+  EXPECT_EQ(2, frames.front_buffer().Get(0, 0));
+  frames.Publish();
+  DrawFrame(frames.back_buffer(), 4);
+  EXPECT_EQ(2, frames.front_buffer().Get(0, 0));
+  ASSERT_TRUE(frames.Acquire());
+  EXPECT_EQ(3, frames.front_buffer().Get(0, 0));
+}
+
+TEST(TripleBufferTest, NeverTearsAcrossThreads) {
+  // Every frame is filled with its own number.
+  const int kFrames = 255;
+  TripleBuffer frames;
+  std::thread producer([&frames]() {
+    for (int frame = 1; frame <= kFrames; frame++) {
+      DrawFrame(frames.back_buffer(), frame);
+      frames.Publish();
+    }
+  });
+
+  int last = 0;
+  int acquired = 0;
+  while (last != kFrames) {
+    if (!frames.Acquire()) {
+      continue;
+    }
+    const Framebuffer& frame = frames.front_buffer();
+    const uint8_t value = frame.Get(0, 0);
+    ASSERT_GT(value, last);
+    for (int y = 0; y < Framebuffer::kHeight; y++) {
+      for (int x = 0; x < Framebuffer::kWidth; x++) {
+        ASSERT_EQ(value, frame.Get(y, x)) << y << " " << x;
+      }
+    }
+    last = value;
+    acquired++;
+  }
+  producer.join();
+  EXPECT_GT(acquired, 0);
+}
+
+} // namespace graphics
+} // namespace backend
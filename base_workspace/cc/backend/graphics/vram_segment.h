@@ -1,77 +1,95 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_MEMORY_VRAM_SEGMENT_H_
 #define TURBO_SANTA_COMMON_BACK_END_MEMORY_VRAM_SEGMENT_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
+#include "cc/backend/debug/diagnostics.h"
+#include "cc/backend/graphics/pixel_kernels.h"
 #include "cc/backend/memory/memory_segment.h"
 #include "glog/logging.h"
 
 namespace backend {
 namespace memory {
 
-class TileData;
-
-class Tile {
+// The tiles in VRAM expanded to one color index per pixel, so that rendering
+// does not have to pick apart the two bitplanes of every pixel. A tile is only
+// decoded again after one of its bytes has been written. Every write also
+// bumps the version of the tile and of the cache as a whole, so that whatever
+// was drawn from a tile can tell whether it is out of date.
+class TileCache {
  public:
-  virtual unsigned char Get(unsigned int y, unsigned int x) = 0;
-  virtual void Set(unsigned int y, unsigned int x, unsigned char value) = 0;
   static const int kTileSize = 8;
-};
-
-class ConcreteTile : public Tile {
- public:
-  virtual unsigned char Get(unsigned int y, unsigned int x) {
-    if (y >= kTileSize || x >= kTileSize) {
-      LOG(FATAL) << "x or y is out of range: x = " << x << " y = " << y;
-    }
-    y *= 2;
-    unsigned char value = 0;
-    unsigned char mask = 0b00000001;
-    mask <<= x;
-    
-    if ((start_ptr_[y] & mask) != 0) {
-      value += 0b00000001;
-    }
-    if ((start_ptr_[y + 1] & mask) != 0) {
-      value += 0b00000010;
-    }
-    return value;
+  static const int kTileNumber = 384;
+  static const int kBytesPerTile = 16;
+
+  TileCache(const std::vector<unsigned char>* data) :
+      data_(data),
+      pixels_(kTileNumber * kTileSize * kTileSize, 0x00),
+      flipped_pixels_(kTileNumber * kTileSize * kTileSize, 0x00),
+      stale_(kTileNumber, true),
+      versions_(kTileNumber, 0) {}
+
+  // Marks the tile holding the byte at offset into the tile data as stale.
+  void Invalidate(int offset) {
+    stale_[offset / kBytesPerTile] = true;
+    versions_[offset / kBytesPerTile]++;
+    version_++;
   }
 
-  virtual void Set(unsigned int y, unsigned int x, unsigned char value) {
-    if (y >= kTileSize || x >= kTileSize) {
-      LOG(FATAL) << "x or y is out of range: x = " << x << " y = " << y;
-    }
-    y *= 2;
-    unsigned char mask = 0b00000001;
-    mask <<= x;
+  uint32_t version(int index) const { return versions_[index]; }
+  uint32_t version() const { return version_; }
 
-    if ((value & 0b00000001) != 0) {
-      start_ptr_[y] |= mask;
-    } else {
-      start_ptr_[y] &= ~mask;
-    }
-    if ((value & 0b00000010) != 0) {
-      start_ptr_[y + 1] |= mask;
-    } else {
-      start_ptr_[y + 1] &= ~mask;
+  // The color indices of row y of the tile, leftmost pixel first or, if
+  // x_flip is set, rightmost pixel first.
+  const unsigned char* row(int index, int y, bool x_flip) {
+    if (stale_[index]) {
+      Decode(index);
     }
+    const std::vector<unsigned char>& pixels = x_flip ? flipped_pixels_ : pixels_;
+    return pixels.data() + (index * kTileSize + y) * kTileSize;
   }
 
  private:
-  unsigned char* start_ptr_ = nullptr;
-  friend class TileData;
+  // Each row is two bytes; the first holds the low bit of each color index
+  // and the second the high bit, with bit 7 being the leftmost pixel.
+  void Decode(int index) {
+    const unsigned char* bytes = data_->data() + index * kBytesPerTile;
+    unsigned char* pixels = pixels_.data() + index * kTileSize * kTileSize;
+    unsigned char* flipped_pixels = flipped_pixels_.data() + index * kTileSize * kTileSize;
+    const graphics::PixelKernels& kernels = graphics::Kernels();
+    for (int y = 0; y < kTileSize; y++) {
+      unsigned char* row = pixels + y * kTileSize;
+      kernels.decode_row(bytes[y * 2], bytes[y * 2 + 1], row);
+      std::reverse_copy(row, row + kTileSize, flipped_pixels + y * kTileSize);
+    }
+    stale_[index] = false;
+  }
+
+  const std::vector<unsigned char>* data_;
+  std::vector<unsigned char> pixels_;
+  std::vector<unsigned char> flipped_pixels_;
+  std::vector<bool> stale_;
+  std::vector<uint32_t> versions_;
+  uint32_t version_ = 0;
 };
 
 class TileData : public ContiguousMemorySegment {
  public:
-  TileData(std::vector<unsigned char>* data, unsigned short start_address) :
-      data_(data), start_address_(start_address) {}
-  virtual unsigned char Read(unsigned short address) { return data_->at(address - lower_address_bound()); }
-  virtual void Write(unsigned short address, unsigned char value) { data_->at(address - lower_address_bound()) = value; }
-  virtual Tile* tile(unsigned char value) {
-    tile_.start_ptr_ = data_->data() + static_cast<unsigned long>(value) * 16;
-    return &tile_;
+  static const unsigned short kTileDataStart = 0x8000;
+
+  TileData(std::vector<unsigned char>* data, TileCache* tile_cache, unsigned short start_address) :
+      data_(data), tile_cache_(tile_cache), start_address_(start_address) {}
+  virtual unsigned char Read(unsigned short address) { return data_->at(address - kTileDataStart); }
+  virtual void Write(unsigned short address, unsigned char value) {
+    data_->at(address - kTileDataStart) = value;
+    tile_cache_->Invalidate(address - kTileDataStart);
+  }
+
+  // Index into the TileCache of the tile which value refers to.
+  virtual int tile_index(unsigned char value) {
+    return (start_address_ - kTileDataStart) / TileCache::kBytesPerTile + value;
   }
 
   static const int kTileDataSize = 0x1000;
@@ -80,22 +98,24 @@ class TileData : public ContiguousMemorySegment {
   unsigned short upper_address_bound() { return lower_address_bound() + kTileDataSize - 1; } // Bound is not length!!!
  private:
   std::vector<unsigned char>* data_;
+  TileCache* tile_cache_;
   unsigned short start_address_;
-  ConcreteTile tile_;
 };
 
 class LowerTileData : public TileData {
  public:
-  LowerTileData(std::vector<unsigned char>* data) : TileData(data, 0x8000) {}
+  LowerTileData(std::vector<unsigned char>* data, TileCache* tile_cache) :
+      TileData(data, tile_cache, 0x8000) {}
 };
 
 class UpperTileData : public TileData {
  public:
-  UpperTileData(std::vector<unsigned char>* data) : TileData(data, 0x8800) {}
+  UpperTileData(std::vector<unsigned char>* data, TileCache* tile_cache) :
+      TileData(data, tile_cache, 0x8800) {}
 
-  virtual Tile* tile(unsigned char value) {
+  virtual int tile_index(unsigned char value) {
     // Actually value is signed so we have to shift it.
-    return TileData::tile(static_cast<char>(value) + 0x80);
+    return TileData::tile_index(static_cast<int8_t>(value) + 0x80);
   }
 };
 
@@ -104,10 +124,19 @@ class BackgroundMap : public ContiguousMemorySegment {
   BackgroundMap(unsigned short start_address) :
       data_(kWidth * kHeight, 0x00), start_address_(start_address) {}
   virtual unsigned char Read(unsigned short address) { return data_[address - lower_address_bound()]; }
-  virtual void Write(unsigned short address, unsigned char value) { data_[address - lower_address_bound()] = value; }
+  virtual void Write(unsigned short address, unsigned char value) {
+    data_[address - lower_address_bound()] = value;
+    version_++;
+  }
 
   virtual unsigned char Get(int y, int x) { return data_[x + y * kWidth]; }
-  virtual void Set(int y, int x, unsigned char value) { data_[x + y * kWidth] = value; }
+  virtual void Set(int y, int x, unsigned char value) {
+    data_[x + y * kWidth] = value;
+    version_++;
+  }
+
+  // Bumped by every write, like TileCache::version.
+  uint32_t version() const { return version_; }
 
   static const int kHeight = 32;
   static const int kWidth = 32;
@@ -117,16 +146,18 @@ class BackgroundMap : public ContiguousMemorySegment {
  private:
   std::vector<unsigned char> data_;
   unsigned short start_address_;
+  uint32_t version_ = 0;
 };
 
 class VRAMSegment : public ContiguousMemorySegment {
  public:
   VRAMSegment() :
       raw_tile_data_(0x97ff - 0x8000 + 1, 0x00),
+      tile_cache_(&raw_tile_data_),
       lower_background_map_(0x9800),
       upper_background_map_(0x9c00),
-      lower_tile_data_(&raw_tile_data_),
-      upper_tile_data_(&raw_tile_data_) {}
+      lower_tile_data_(&raw_tile_data_, &tile_cache_),
+      upper_tile_data_(&raw_tile_data_, &tile_cache_) {}
 
   virtual unsigned char Read(unsigned short address) {
     // if (!enabled_) {
@@ -152,20 +183,16 @@ class VRAMSegment : public ContiguousMemorySegment {
     // }
 
     if (lower_background_map_.InRange(address)) {
-      LOG(INFO) << "Writting " << std::hex << 0x0000 + value << " to "
-                << std::hex << address << " in LowerBackgroundMap";
+      DIAGNOSE(2, VRAM, "Wrote 0x%x to 0x%x in LowerBackgroundMap", value, address);
       lower_background_map_.Write(address, value);
     } else if (upper_background_map_.InRange(address)) {
-      LOG(INFO) << "Writting " << std::hex << 0x0000 + value << " to "
-                << std::hex << address << " in UpperBackgroundMap";
+      DIAGNOSE(2, VRAM, "Wrote 0x%x to 0x%x in UpperBackgroundMap", value, address);
       upper_background_map_.Write(address, value);
     } else if (lower_tile_data_.InRange(address)) {
-      LOG(INFO) << "Writting " << std::hex << 0x0000 + value << " to "
-                << std::hex << address << " in LowerTileData";
+      DIAGNOSE(2, VRAM, "Wrote 0x%x to 0x%x in LowerTileData", value, address);
       lower_tile_data_.Write(address, value);
     } else if (upper_tile_data_.InRange(address)) {
-      LOG(INFO) << "Writting " << std::hex << 0x0000 + value << " to "
-                << std::hex << address << " in UpperTileData";
+      DIAGNOSE(2, VRAM, "Wrote 0x%x to 0x%x in UpperTileData", value, address);
       upper_tile_data_.Write(address, value);
     } else {
       LOG(FATAL) << "Attempted Write outside of owned region: " << address;
@@ -180,6 +207,7 @@ class VRAMSegment : public ContiguousMemorySegment {
   BackgroundMap* upper_background_map() { return &upper_background_map_; }
   TileData* lower_tile_data() { return &lower_tile_data_; }
   TileData* upper_tile_data() { return &upper_tile_data_; }
+  TileCache* tile_cache() { return &tile_cache_; }
 
  protected:
   unsigned short lower_address_bound() { return 0x8000; }
@@ -188,6 +216,7 @@ class VRAMSegment : public ContiguousMemorySegment {
  private:
   bool enabled_ = true;
   std::vector<unsigned char> raw_tile_data_;
+  TileCache tile_cache_;
   BackgroundMap lower_background_map_;
   BackgroundMap upper_background_map_;
   LowerTileData lower_tile_data_;
@@ -201,7 +230,8 @@ class SpriteAttribute {
   unsigned char y() { return data_[0]; }
   unsigned char x() { return data_[1]; }
   unsigned char tile_index() { return data_[2]; }
-  bool over_background() { return bit(7); }
+  // Set if the background's colors 1-3 are drawn over the sprite.
+  bool behind_background() { return bit(7); }
   bool y_flip() { return bit(6); }
   bool x_flip() { return bit(5); }
   bool palette() { return bit(4); }
@@ -225,7 +255,21 @@ class OAMSegment : public ContiguousMemorySegment {
   OAMSegment() : data_(kEndAddress - kStartAddress + 1, 0) {}
 
   virtual unsigned char Read(unsigned short address) { return data_[address - kStartAddress]; }
-  virtual void Write(unsigned short address, unsigned char value) { data_[address - kStartAddress] = value; }
+  virtual void Write(unsigned short address, unsigned char value) {
+    data_[address - kStartAddress] = value;
+    changed_ = true;
+  }
+
+  // OAM DMA copies straight into here, so handing out the storage counts as a
+  // change.
+  virtual unsigned char* storage(unsigned short address) {
+    changed_ = true;
+    return data_.data() + (address - kStartAddress);
+  }
+
+  // Whether OAM may have been written since the last clear_changed.
+  bool has_changed() { return changed_; }
+  void clear_changed() { changed_ = false; }
 
   virtual void Enable() { enabled_ = true; }
   virtual void Disable() { enabled_ = false; }
@@ -247,6 +291,7 @@ class OAMSegment : public ContiguousMemorySegment {
   std::vector<unsigned char> data_;
   SpriteAttribute sprite_attribute_;
   bool enabled_ = true;
+  bool changed_ = true;
 };
 
 } // namespace memory
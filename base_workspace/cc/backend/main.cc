@@ -1,16 +1,18 @@
 #include <curses.h>
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <vector>
 #include <thread>
 
-#include <errno.h>
 #include <stdio.h>
-#include <string.h>
 
 #include "cc/backend/clocktroller/clocktroller.h"
 #include "cc/backend/memory/joypad/joypad_module.h"
+#include "cc/backend/memory/mbc/rom_image.h"
+#include "cc/backend/graphics/presenter.h"
 #include "cc/backend/graphics/screen.h"
 // #include "cc/backend/debugger/frames.h"
 // #include "cc/backend/debugger/deltas.h"
@@ -22,21 +24,28 @@ using std::cout;
 using std::endl;
 using std::hex;
 using std::dec;
+using std::shared_ptr;
 using std::string;
 using std::thread;
 using std::vector;
 using backend::clocktroller::Clocktroller;
+using backend::debug::memory_profiler::MemoryProfiler;
 // using backend::debugger::Frame;
 // using backend::debugger::RegisterDelta;
 // using backend::debugger::MemoryDelta;
 // using backend::debugger::GreatLibrary;
 using backend::graphics::DefaultRaster;
+using backend::graphics::Presenter;
 using backend::graphics::Screen;
 using backend::graphics::ScreenRaster;
 using backend::memory::JoypadFlag;
+using backend::memory::ROMImage;
 
 static const int kNintendoLogoStartPosition = 0x104;
 
+// How often the memory profile is written out while the emulator runs.
+static const std::chrono::seconds kMemoryProfileInterval(1);
+
 static const vector<unsigned char> kNintendoLogo = {
     0xce, 0xed, 0x66, 0x66, 0xcc, 0x0d, 0x00, 0x0b, 
     0x03, 0x73, 0x00, 0x83, 0x00, 0x0c, 0x00, 0x0d,
@@ -88,26 +97,6 @@ vector<unsigned char> BuildROM() {
   return rom;
 }
 
-vector<unsigned char> ReadROM(string file_name) {
-  FILE* file = fopen(file_name.c_str(), "r");
-  size_t file_length;
-  if (file == nullptr) {
-    LOG(FATAL) << "Cannot read file " << file_name << ": " << strerror(errno);
-  }
-
-  // Gets file length.
-  fseek(file, 0, SEEK_END);
-  file_length = ftell(file);
-  rewind(file);
-
-  // Read file.
-  vector<unsigned char> rom(file_length);
-  fread(rom.data(), 1, file_length, file);
-
-  fclose(file);
-  return rom;
-}
-
 // void printFrame(Frame& frame) {
 //   cout << "Event: " << frame.event() << endl;
 //   cout << "Timestamp: " << dec << frame.timestamp() << endl;
@@ -231,8 +220,9 @@ vector<unsigned char> ReadROM(string file_name) {
 //   }
 // }
 
-void HandleInput(Clocktroller* clocktroller) {
+void HandleInput(Clocktroller* clocktroller, bool has_memory_profile) {
   JoypadFlag* joypad_flag = clocktroller->joypad_flag();
+  bool memory_profiling = has_memory_profile;
   cbreak();
   bool running = true;
   while (running) {
@@ -261,6 +251,13 @@ void HandleInput(Clocktroller* clocktroller) {
       case 'k':
         joypad_flag->set_b(true);
         break;
+      case 'p':
+        // Without a file to write them to the counts would be lost.
+        if (has_memory_profile) {
+          memory_profiling = !memory_profiling;
+          clocktroller->set_memory_profiling(memory_profiling);
+        }
+        break;
       case '\\':
         clocktroller->Kill();
         running = false;
@@ -272,26 +269,46 @@ void HandleInput(Clocktroller* clocktroller) {
 }
 
 int main(int argc, char* argv[]) {
-  if (argc != 2) {
-    printf("Please provide the name of the ROM\n");
+  if (argc != 2 && argc != 3) {
+    printf("Usage: turbo ROM [MEMORY_PROFILE]\n");
+    printf("With MEMORY_PROFILE, every memory access is profiled and the counts\n");
+    printf("are written to it as CSV every second and on exit; p then turns\n");
+    printf("profiling off and on again while running.\n");
     return -1;
   }
+  const bool has_memory_profile = argc == 3;
 
   google::InstallFailureSignalHandler();
 
   TerminalScreen terminal_screen;
 //   GreatLibrary great_library;
-  vector<unsigned char> rom = ReadROM(argv[1]);
-  LOG(INFO) << "Finished reading rom";
+  shared_ptr<ROMImage> rom = ROMImage::Map(argv[1]);
+  if (rom == nullptr) {
+    LOG(FATAL) << "Cannot read ROM " << argv[1];
+  }
+  LOG(INFO) << "Finished mapping rom";
   Clocktroller clocktroller(&terminal_screen);
   LOG(INFO) << "Clocktroller built";
 
   initscr();
-  clocktroller.Init(rom.data(), rom.size());
+  clocktroller.Init(rom);
+  // Drawing to the terminal is slow, so it is done off the emulation thread.
+  Presenter presenter(&terminal_screen);
+  clocktroller.AttachPresenter(&presenter);
+  if (has_memory_profile) {
+    clocktroller.memory_profiler()->set_snapshot_interval(kMemoryProfileInterval, argv[2],
+                                                          MemoryProfiler::CSV);
+    clocktroller.set_memory_profiling(true);
+  }
   clocktroller.Run();
-  thread input_thread(HandleInput, &clocktroller);
+  thread input_thread(HandleInput, &clocktroller, has_memory_profile);
   clocktroller.Wait();
   input_thread.join();
+  presenter.Stop();
+  if (has_memory_profile &&
+      !clocktroller.memory_profiler()->WriteSnapshot(argv[2], MemoryProfiler::CSV)) {
+    LOG(ERROR) << "Cannot write the memory profile to " << argv[2];
+  }
   endwin();
 //   ViewHistory(&great_library);
   return 0;
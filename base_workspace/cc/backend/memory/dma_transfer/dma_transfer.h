@@ -5,37 +5,42 @@
 #include "cc/backend/memory/flags.h"
 #include "cc/backend/memory/memory_mapper.h"
 #include "cc/backend/memory/module.h"
+#include "cc/backend/scheduler/scheduler.h"
 
 namespace backend {
 namespace memory {
 
+// Writing the upper byte of a source address copies 160 bytes from there into
+// OAM. The copy itself happens at once, but for the 160 machine cycles the
+// real transfer takes the CPU can only reach 0xff00-0xffff, which is why games
+// run the transfer from a routine in high RAM.
 class DMATransferFlag : public Flag {
  public:
-  DMATransferFlag(MemoryMapper* mapper) : Flag(0xff46), mapper_(mapper) {}
+  static const int kTransferCycles = 640;
+  static const unsigned short kOAMStart = 0xfe00;
+  static const int kOAMSize = 0xa0;
+
+  DMATransferFlag(MemoryMapper* mapper, scheduler::Scheduler* scheduler) :
+      Flag(0xff46), mapper_(mapper), scheduler_(scheduler) {}
 
   unsigned char Read(unsigned short) { return 0xff; }
 
   void Write(unsigned short, unsigned char value) {
-    // TODO(Brendan): This should actually take the expected amount of time.
-    // This should also disable all memory outside of high RAM.
-    unsigned short source_address = value * 0x100;
-    unsigned short destination_address = 0xfe00;
-    while (destination_address <= 0xfe9f) {
-      unsigned char value = mapper_->Read(source_address);
-      mapper_->Write(destination_address, value);
-      source_address++;
-      destination_address++;
-    }
+    mapper_->Copy(value << 8, kOAMStart, kOAMSize);
+    mapper_->set_bus_locked(true);
+    scheduler_->Schedule(&end_event_, scheduler_->now() + kTransferCycles);
   }
 
  private:
   MemoryMapper* mapper_;
+  scheduler::Scheduler* scheduler_;
+  scheduler::Event end_event_ = scheduler::Event([this](uint64_t) { mapper_->set_bus_locked(false); });
 };
 
 class DMATransferModule : public Module {
  public:
-  void Init(MemoryMapper* memory_mapper) {
-    flag_ = std::unique_ptr<DMATransferFlag>(new DMATransferFlag(memory_mapper));
+  void Init(MemoryMapper* memory_mapper, scheduler::Scheduler* scheduler) {
+    flag_ = std::unique_ptr<DMATransferFlag>(new DMATransferFlag(memory_mapper, scheduler));
     add_flag(flag_.get());
   }
 
@@ -0,0 +1,74 @@
+#include "cc/backend/memory/dma_transfer/dma_transfer.h"
+
+#include "cc/backend/memory/memory_mapper.h"
+#include "cc/backend/memory/module.h"
+#include "cc/backend/memory/ram/default_module.h"
+#include "cc/backend/memory/ram/ram_segment.h"
+#include "cc/backend/scheduler/scheduler.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace memory {
+
+namespace {
+
+// Stands in for the graphics controller's OAM.
+class OAMModule : public Module {
+ public:
+  OAMModule() { add_memory_segment(&oam_); }
+
+ private:
+  RAMSegment oam_ = RAMSegment(0xfe00, 0xfe9f);
+};
+
+class DMATransferTest : public ::testing::Test {
+ protected:
+  DMATransferTest() {
+    default_module_.Init();
+    memory_mapper_.RegisterModule(default_module_);
+    memory_mapper_.RegisterModule(oam_module_);
+    dma_transfer_module_.Init(&memory_mapper_, &scheduler_);
+    memory_mapper_.RegisterModule(dma_transfer_module_);
+  }
+
+  scheduler::Scheduler scheduler_;
+  MemoryMapper memory_mapper_;
+  DefaultModule default_module_;
+  OAMModule oam_module_;
+  DMATransferModule dma_transfer_module_;
+};
+
+} // namespace
+
+TEST_F(DMATransferTest, CopiesIntoOAM) {
+  for (int i = 0; i < DMATransferFlag::kOAMSize; i++) {
+    memory_mapper_.Write(0xc000 + i, i);
+  }
+  memory_mapper_.Write(0xff46, 0xc0);
+
+  for (int i = 0; i < DMATransferFlag::kOAMSize; i++) {
+    ASSERT_EQ(i, memory_mapper_.Peek(DMATransferFlag::kOAMStart + i)) << i;
+  }
+}
+
+TEST_F(DMATransferTest, LocksEverythingButHighMemoryUntilTheTransferEnds) {
+  memory_mapper_.Write(0xc000, 0x42);
+  memory_mapper_.Write(0xff80, 0x24);
+  memory_mapper_.Write(0xff46, 0xc0);
+
+  EXPECT_EQ(0xff, memory_mapper_.Read(0xc000));
+  EXPECT_EQ(0x42, memory_mapper_.Peek(0xc000));
+  EXPECT_EQ(0x24, memory_mapper_.Read(0xff80));
+  memory_mapper_.Write(0xc000, 0x00);
+
+  scheduler_.Advance(DMATransferFlag::kTransferCycles - 1);
+  scheduler_.RunDueEvents();
+  EXPECT_EQ(0xff, memory_mapper_.Read(0xc000));
+
+  scheduler_.Advance(1);
+  scheduler_.RunDueEvents();
+  EXPECT_EQ(0x42, memory_mapper_.Read(0xc000));
+}
+
+} // namespace memory
+} // namespace backend
@@ -1,7 +1,6 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_MEMORY_FLAG_CONTAINER_H_
 #define TURBO_SANTA_COMMON_BACK_END_MEMORY_FLAG_CONTAINER_H_
 
-#include <vector>
 #include "cc/backend/memory/flags.h"
 #include "cc/backend/memory/memory_segment.h"
 
@@ -13,34 +12,40 @@ namespace memory {
 
 class FlagContainer : public ContiguousMemorySegment {
  public:
-  unsigned char Read(unsigned short address) {
-    for (Flag* flag : flags_) {
-      if (flag->InRange(address)) {
-        return flag->Read(address);
-      }
+  static const int kPortNumber = 0x80;
+
+  FlagContainer() : unmapped_(0xff00, 0xff7f) {
+    for (int i = 0; i < kPortNumber; i++) {
+      ports_[i] = &unmapped_;
     }
-    return 0;
   }
 
-  void Write(unsigned short address, unsigned char value) {
-    for (Flag* flag : flags_) {
-      if (flag->InRange(address)) {
-        flag->Write(address, value);
-        return;
-      }
+  unsigned char Read(unsigned short address) { return port(address)->Read(address); }
+
+  void Write(unsigned short address, unsigned char value) { port(address)->Write(address, value); }
+
+  // If two flags claim the same port the first one added keeps it.
+  void add_flag(Flag* flag) {
+    MemorySegment** entry = &ports_[flag->address() - 0xff00];
+    if (*entry == &unmapped_) {
+      *entry = flag;
     }
   }
 
-  void add_flag(Flag* flag) { flags_.push_back(flag); }
+  // The flag at this address, or a segment which reads 0 and ignores writes
+  // if no flag has been added there.
+  MemorySegment* port(unsigned short address) { return ports_[(address - 0xff00) & 0x7f]; }
 
  protected:
-  std::vector<Flag*> flags_;
-
   // Inclusive lower bound of this memory segment.
   virtual unsigned short lower_address_bound() { return 0xff00; } 
 
   // Inclusive upper bound of this memory segment.
   virtual unsigned short upper_address_bound() { return 0xff7f; }
+
+ private:
+  NullMemorySegment unmapped_;
+  MemorySegment* ports_[kPortNumber];
 };
 
 } // namespace memory
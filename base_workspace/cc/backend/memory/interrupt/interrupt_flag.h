@@ -1,6 +1,7 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_MEMORY_INTERRUPT_FLAG_H_
 #define TURBO_SANTA_COMMON_BACK_END_MEMORY_INTERRUPT_FLAG_H_
 
+#include "cc/backend/debug/diagnostics.h"
 #include "cc/backend/memory/flags.h"
 #include "glog/logging.h"
 
@@ -34,18 +35,8 @@ class InterruptBase : public Flag {
 
   virtual unsigned char Read(unsigned short) { return value_; }
   virtual void Write(unsigned short, unsigned char value) { 
-    LOG(INFO) << "Interrupt flag written to.";
-    LOG(INFO) << "v_blank = " << v_blank();
-    LOG(INFO) << "lcd_stat = " << lcd_stat();
-    LOG(INFO) << "timer = " << timer();
-    LOG(INFO) << "serial = " << serial();
-    LOG(INFO) << "joypad = " << joypad();
+    DIAGNOSE(1, INTERRUPTS, "0x%x written to, 0x%x to 0x%x.", address(), value_, value);
     value_ = value;
-    LOG(INFO) << "v_blank = " << v_blank();
-    LOG(INFO) << "lcd_stat = " << lcd_stat();
-    LOG(INFO) << "timer = " << timer();
-    LOG(INFO) << "serial = " << serial();
-    LOG(INFO) << "joypad = " << joypad();
   }
   virtual bool v_blank() { return value_bit(0); }
   virtual bool lcd_stat() { return value_bit(1); }
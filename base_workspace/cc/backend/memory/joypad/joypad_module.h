@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <memory>
+#include "cc/backend/debug/diagnostics.h"
 #include "cc/backend/memory/flags.h"
 #include "cc/backend/memory/interrupt/interrupt_flag.h"
 #include "cc/backend/memory/module.h"
@@ -21,27 +22,27 @@ class JoypadFlag : public Flag {
     uint8_t button_keys_selected = (!is_button_keys_selected_) << 5;
     uint8_t direction_keys_selected = (!is_direction_keys_selected_) << 4;
     if (is_button_keys_selected_ && is_direction_keys_selected_) {
-      LOG(ERROR) << "Both button matrices selected durring read.";
+      DIAGNOSE(1, JOYPAD, "Both button matrices selected durring read.");
       return button_keys_selected 
           | direction_keys_selected 
           | button_keys_ 
           | direction_keys_;
     } else if (is_button_keys_selected_) {
       if (~(0b11110000 | button_keys_)) {
-        LOG(INFO) << "Reading set button keys.";
+        DIAGNOSE(2, JOYPAD, "Reading set button keys.");
       } else {
-        LOG(INFO) << "Reading unset button keys.";
+        DIAGNOSE(2, JOYPAD, "Reading unset button keys.");
       }
       return button_keys_selected | direction_keys_selected | button_keys_;
     } else if (is_direction_keys_selected_) {
       if (~(0b11110000 | direction_keys_)) {
-        LOG(INFO) << "Reading set direction keys.";
+        DIAGNOSE(2, JOYPAD, "Reading set direction keys.");
       } else {
-        LOG(INFO) << "Reading unset direction keys.";
+        DIAGNOSE(2, JOYPAD, "Reading unset direction keys.");
       }
       return button_keys_selected | direction_keys_selected | direction_keys_;
     } else {
-      LOG(ERROR) << "Neither button matrices selected durring read.";
+      DIAGNOSE(1, JOYPAD, "Neither button matrices selected durring read.");
       return button_keys_selected | direction_keys_selected;
     }
   }
@@ -69,13 +70,13 @@ class JoypadFlag : public Flag {
   InterruptFlag* interrupt_flag_;
 
   void set_button_keys(int value) {
-    LOG(INFO) << "Setting joypad input.";
+    DIAGNOSE(1, JOYPAD, "Setting joypad input %d.", value);
     button_keys_ &= ~(1 << value);
     interrupt_flag_->set_joypad(true);
   }
 
   void unset_button_keys(int value) {
-    LOG(INFO) << "Unsetting joypad input.";
+    DIAGNOSE(1, JOYPAD, "Unsetting joypad input %d.", value);
     button_keys_ |= (1 << value);
     interrupt_flag_->set_joypad(true);
   }
@@ -89,13 +90,13 @@ class JoypadFlag : public Flag {
   }
 
   void set_direction_keys(int value) {
-    LOG(INFO) << "Setting joypad input.";
+    DIAGNOSE(1, JOYPAD, "Setting joypad input %d.", value);
     direction_keys_ &= ~(1 << value);
     interrupt_flag_->set_joypad(true);
   }
 
   void unset_direction_keys(int value) {
-    LOG(INFO) << "Unsetting joypad input.";
+    DIAGNOSE(1, JOYPAD, "Unsetting joypad input %d.", value);
     direction_keys_ |= (1 << value);
     interrupt_flag_->set_joypad(true);
   }
@@ -6,78 +6,19 @@
 namespace backend {
 namespace memory {
 
+using std::shared_ptr;
 using std::unique_ptr;
 using std::vector;
 
 // TODO(Brendan): Finish this.
-MBC* CreateNoMBC(unsigned char* program_rom, long size) {
-  ROMBank rom_bank_0;
-  ROMBank rom_bank_1;
-  RAMBank ram_bank_0;
-  CreateROMBanks(program_rom, size, &rom_bank_0, &rom_bank_1);
-  return new NoMBC(rom_bank_0, rom_bank_1, ram_bank_0);
+MBC* CreateNoMBC(shared_ptr<ROMImage> program_rom) {
+  return new NoMBC(program_rom, RAMBank());
 }
 
-MBC* CreateMBC1(unsigned char* program_rom, long size) {
-  ROMBank rom_bank_0;
-  vector<ROMBank> rom_bank_n;
+MBC* CreateMBC1(shared_ptr<ROMImage> program_rom) {
   vector<RAMBank> ram_bank_n;
-  CreateROMBanks(program_rom, size, &rom_bank_0, &rom_bank_n);
   CreateRAMBanks(4, &ram_bank_n);
-  return new MBC1(rom_bank_0, rom_bank_n, ram_bank_n);
-}
-
-void CreateROMBanks(unsigned char* rom, long rom_size, ROMBank* rom_bank_0, ROMBank* rom_bank_1) {
-  int address = 0;
-  int i = 0;
-  while (i < MBC::kROMBank0Size && address < rom_size) {
-    rom_bank_0->memory_[i] = rom[address];
-    address++;
-    i++;
-  }
-
-  i = 0;
-  while (i < MBC::kROMBankNSize && address < rom_size) {
-    rom_bank_1->memory_[i] = rom[address];
-    address++;
-    i++;
-  }
-}
-
-void CreateROMBanks(unsigned char* rom, long rom_size, ROMBank* rom_bank_0, std::vector<ROMBank>* rom_bank_n) {
-  LOG(INFO) << "Creating ROM banks";
-  LOG(INFO) << "ROM size = " << rom_size;
-
-  int address = 0;
-  int i = 0;
-  while (i < MBC::kROMBank0Size && address < rom_size) {
-    rom_bank_0->memory_[i] = rom[address];
-    address++;
-    i++;
-  }
-  LOG(INFO) << "Created ROM 0";
-
-  int n = 1;
-  while (address < rom_size) {
-    ROMBank rom_bank;
-    i = 0;
-    while (i < MBC::kROMBankNSize && address < rom_size) {
-      rom_bank.memory_[i] = rom[address];
-      address++;
-      i++;
-    }
-    rom_bank_n->push_back(rom_bank);
-    LOG(INFO) << "Created ROM " <<  n;
-    n++;
-  }
-}
-
-unsigned char ROMBank::Read(unsigned short address) {
-  return memory_[address];
-}
-
-void ROMBank::ForceWrite(unsigned short address, unsigned char value) {
-  memory_[address] = value;
+  return new MBC1(program_rom, ram_bank_n);
 }
 
 void CreateRAMBanks(int bank_number, vector<RAMBank>* ram_bank_n) {
@@ -94,8 +35,8 @@ void RAMBank::Write(unsigned short address, unsigned char value) {
   memory_[address] = value;
 }
 
-unique_ptr<MBC> ConstructMBC(unsigned char* program_rom, long size) {
-  MBC::CartridgeType cartridge_type = GetCartridgeType(program_rom[0x147]);
+unique_ptr<MBC> ConstructMBC(shared_ptr<ROMImage> program_rom) {
+  MBC::CartridgeType cartridge_type = GetCartridgeType(program_rom->data()[0x147]);
   // TODO(Brendan): We should have some type of check on the ROM/RAM size, I do
   // not know what the behavior should be if the ROM states an incorrect size.
 //   int rom_bank_number = GetROMBankNumber(program_rom[0x148]);
@@ -106,12 +47,12 @@ unique_ptr<MBC> ConstructMBC(unsigned char* program_rom, long size) {
     case MBC::ROM_AND_RAM:
     case MBC::ROM_AND_RAM_BATTERY:
       LOG(INFO) << "Creating NoMBC";
-      return unique_ptr<MBC>(CreateNoMBC(program_rom, size));
+      return unique_ptr<MBC>(CreateNoMBC(program_rom));
     case MBC::MBC1:
     case MBC::MBC1_WITH_RAM:
     case MBC::MBC1_WITH_RAM_BATTERY:
       LOG(INFO) << "Creating MBC1";
-      return unique_ptr<MBC>(CreateMBC1(program_rom, size));
+      return unique_ptr<MBC>(CreateMBC1(program_rom));
     case MBC::UNSUPPORTED:
     default:
       LOG(FATAL) << "Cartridge Type, " << cartridge_type << ", is unsupported";
@@ -157,6 +98,13 @@ void NoMBC::ForceWrite(unsigned short address, unsigned char value) {
   }
 }
 
+int NoMBC::bank(unsigned short address) {
+  if (0x4000 <= address && address <= 0x7fff) {
+    return 1;
+  }
+  return 0;
+}
+
 void MBC1::BankModeRegister::SetLowerBits(unsigned char value) {
   if ((value & 0b00011111) == 0x00) {
     // The MBC translates writing 0x00 here to writing 0x01.
@@ -195,21 +143,21 @@ unsigned char MBC1::BankModeRegister::GetROMBank() {
   }
 }
 
-unsigned char MBC1::ROMBankN::ComputeROMBank() {
-  unsigned char bank_number = bank_mode_register_->GetROMBank();
-  
-  // Since certain bank values are skipped we must translate bank address space
-  // into the index space with respect to the vector which holds the actual
-  // memory blocks.
-  if (bank_number > 0x60) {
-    return bank_number - 4;
-  } else if (bank_number > 0x40) {
-    return bank_number - 3;
-  } else if (bank_number > 0x20) {
-    return bank_number - 2;
-  } else {
-    return bank_number - 1;
+void MBC1::ROMBankN::Select() {
+  // The cartridge only wires up as many bank number bits as the ROM needs, so
+  // the unused upper bits are ignored. This is applied after the 0 to 1
+  // translation of the lower bits; a ROM of four banks which selects bank 4
+  // gets bank 0. ROM sizes are powers of two, but an image which is not is
+  // wrapped back into range.
+  int mask = 1;
+  while (mask < rom_->bank_number()) {
+    mask <<= 1;
   }
+  bank_ = bank_mode_register_->GetROMBank() & (mask - 1);
+  if (bank_ >= rom_->bank_number()) {
+    bank_ %= rom_->bank_number();
+  }
+  current_ = ROMBank(rom_->bank(bank_));
 }
 
 unsigned char MBC1::Read(unsigned short address) {
@@ -226,15 +174,15 @@ unsigned char MBC1::Read(unsigned short address) {
 void MBC1::Write(unsigned short address, unsigned char value) {
   if (0x0000 <= address && address <= 0x1fff) {
     SetRAMEnabled(value);
-    LOG(INFO) << std::hex << 0x0000 + value << " was written to RAM enable region";
-    LOG(INFO) << "RAM enabled = " << ram_enabled_;
   } else if (0x2000 <= address && address <= 0x3fff) {
     bank_mode_register_.SetLowerBits(value);
-    LOG(INFO) << "ROM bank " << static_cast<int>(bank_mode_register_.GetROMBank()) << " was selected";
+    rom_bank_n_.Select();
   } else if (0x4000 <= address && address <= 0x5fff) {
     bank_mode_register_.SetUpperBits(value);
+    rom_bank_n_.Select();
   } else if (0x6000 <= address && address <= 0x7fff) {
     bank_mode_register_.SetIsRAMMode(value);
+    rom_bank_n_.Select();
   } else if (0xa000 <= address && address <= 0xbfff) {
     if (ram_enabled_) {
       ram_bank_n_.Write(address - 0xa000, value);
@@ -252,13 +200,22 @@ void MBC1::Write(unsigned short address, unsigned char value) {
 void MBC1::ForceWrite(unsigned short address, unsigned char value) {
   if (0x0000 <= address && address <= 0x3fff) {
     rom_bank_0_.ForceWrite(address - 0x0000, value);
-  } else if (0x4000 <= address && address <= 0x4000) {
+  } else if (0x4000 <= address && address <= 0x7fff) {
     rom_bank_n_.ForceWrite(address - 0x4000, value);
   } else if (0xa000 <= address && address <= 0xbfff) {
-    rom_bank_n_.ForceWrite(address - 0xa000, value);
+    ram_bank_n_.ForceWrite(address - 0xa000, value);
   } else {
-    LOG(FATAL) << "Read attempted outside of MBC region: " << address;
+    LOG(FATAL) << "ForceWrite attempted outside of MBC region: " << address;
+  }
+}
+
+int MBC1::bank(unsigned short address) {
+  if (0x4000 <= address && address <= 0x7fff) {
+    return rom_bank_n_.bank();
+  } else if (0xa000 <= address && address <= 0xbfff) {
+    return bank_mode_register_.GetRAMBank();
   }
+  return 0;
 }
 
 void MBC1::SetRAMEnabled(unsigned char value) {
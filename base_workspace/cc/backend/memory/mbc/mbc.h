@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 
+#include "cc/backend/memory/mbc/rom_image.h"
 #include "cc/backend/memory/memory_segment.h"
 
 namespace test_harness {
@@ -19,24 +20,18 @@ class ClocktrollerTest;
 namespace backend {
 namespace memory {
 
-class ROMBank;
-
-void CreateROMBanks(unsigned char* rom, long rom_size, ROMBank* rom_bank_0, ROMBank* rom_bank_1);
-void CreateROMBanks(unsigned char* rom, long rom_size, ROMBank* rom_bank_0, std::vector<ROMBank>* rom_bank_n);
-
+// A view of one bank of a ROMImage; copying it copies the view, not the bank.
 class ROMBank {
  public:
-  ROMBank() : memory_(0x4000, 0x00) {}
+  ROMBank() = default;
+  explicit ROMBank(unsigned char* memory) : memory_(memory) {}
 
-  virtual unsigned char Read(unsigned short address);
+  unsigned char Read(unsigned short address) { return memory_[address]; }
 
-  virtual void ForceWrite(unsigned short address, unsigned char value);
+  void ForceWrite(unsigned short address, unsigned char value) { memory_[address] = value; }
 
  private:
-  std::vector<unsigned char> memory_;
-
-  friend void CreateROMBanks(unsigned char* rom, long rom_size, ROMBank* rom_bank_0, ROMBank* rom_bank_1);
-  friend void CreateROMBanks(unsigned char* rom, long rom_size, ROMBank* rom_bank_0, std::vector<ROMBank>* rom_bank_1);
+  unsigned char* memory_ = nullptr;
 };
 
 class RAMBank;
@@ -86,19 +81,28 @@ class MBC : public MemorySegment {
     virtual bool InRange(unsigned short address) { 
       return (kROMMinAddress <= address && address <= kROMMaxAddress) || (kRAMMinAddress <= address && address <= kRAMMaxAddress);
     }
+
+    // ROM bank 0 is always bank 0; switchable ROM banks are numbered from 1.
+    // Cartridge RAM is numbered by its own banks, from 0.
+    virtual int bank(unsigned short) { return 0; }
     
   protected:
+    explicit MBC(std::shared_ptr<ROMImage> rom) : rom_(rom) {}
+
+    // Every ROMBank of the MBC points into rom_.
+    std::shared_ptr<ROMImage> rom_;
+
     virtual unsigned short lower_address_bound() { return 0x0000; }
     virtual unsigned short upper_address_bound() { return 0xbfff; }
     friend class test_harness::TestHarness;
     friend class clocktroller::ClocktrollerTest;
 };
 
-std::unique_ptr<MBC> ConstructMBC(unsigned char* program_rom, long size);
+std::unique_ptr<MBC> ConstructMBC(std::shared_ptr<ROMImage> program_rom);
 
-MBC* CreateNoMBC(unsigned char* program_rom, long size);
+MBC* CreateNoMBC(std::shared_ptr<ROMImage> program_rom);
 
-MBC* CreateMBC1(unsigned char* program_rom, long size);
+MBC* CreateMBC1(std::shared_ptr<ROMImage> program_rom);
 
 MBC::CartridgeType GetCartridgeType(unsigned char cartridge_type_value);
 
@@ -108,12 +112,13 @@ int GetRAMBankNumber(unsigned char ram_size_value);
 
 class NoMBC : public MBC {
  public:
-  NoMBC(ROMBank rom_bank_0, ROMBank rom_bank_1, RAMBank ram_bank_0)
-      : rom_bank_0_(rom_bank_0), rom_bank_1_(rom_bank_1), ram_bank_0_(ram_bank_0) {}
+  NoMBC(std::shared_ptr<ROMImage> rom, RAMBank ram_bank_0)
+      : MBC(rom), rom_bank_0_(rom->bank(0)), rom_bank_1_(rom->bank(1)), ram_bank_0_(ram_bank_0) {}
 
   virtual unsigned char Read(unsigned short address);
   virtual void Write(unsigned short address, unsigned char value);
   virtual void ForceWrite(unsigned short address, unsigned char value) override;
+  virtual int bank(unsigned short address) override;
 
  protected:
   ROMBank rom_bank_0_;
@@ -123,12 +128,13 @@ class NoMBC : public MBC {
 
 class MBC1 : public MBC {
   public:
-   MBC1(ROMBank rom_bank_0, std::vector<ROMBank> rom_bank_n, std::vector<RAMBank> ram_bank_n)
-       : rom_bank_0_(rom_bank_0), rom_bank_n_(rom_bank_n, &bank_mode_register_), ram_bank_n_(ram_bank_n, &bank_mode_register_) {}
+   MBC1(std::shared_ptr<ROMImage> rom, std::vector<RAMBank> ram_bank_n)
+       : MBC(rom), rom_bank_0_(rom->bank(0)), rom_bank_n_(rom.get(), &bank_mode_register_), ram_bank_n_(ram_bank_n, &bank_mode_register_) {}
 
     virtual unsigned char Read(unsigned short address);
     virtual void Write(unsigned short address, unsigned char value);
     virtual void ForceWrite(unsigned short address, unsigned char value) override;
+    virtual int bank(unsigned short address) override;
    
     // The documentation stated
     // that the gameboy game may change the ROM/RAM addressing mode at anytime
@@ -160,34 +166,38 @@ class MBC1 : public MBC {
 
       private:
         // 7-bit register that stores that sets the selected ROM/RAM address(es).
-        unsigned char register_ = 0;
+        // Starts out as though 0x00 had been written to the lower bits.
+        unsigned char register_ = 0b00000001;
         bool is_ram_mode_ = false;
     };
 
+    // Views the selected bank, which is only recomputed when the
+    // BankModeRegister is written, so switching banks is a pointer swap.
     class ROMBankN {
       public:
-       ROMBankN(std::vector<ROMBank> banks, BankModeRegister* bank_mode_register) : 
-           banks_(banks), bank_mode_register_(bank_mode_register) {}
+       ROMBankN(ROMImage* rom, BankModeRegister* bank_mode_register) :
+           rom_(rom), bank_mode_register_(bank_mode_register) {
+         Select();
+       }
 
-        virtual unsigned char Read(unsigned short address) {
-          return banks_[ComputeROMBank()].Read(address);
+        unsigned char Read(unsigned short address) {
+          return current_.Read(address);
         }
 
-        virtual void ForceWrite(unsigned short address, unsigned char value) {
-          banks_[ComputeROMBank()].ForceWrite(address, value);
+        void ForceWrite(unsigned short address, unsigned char value) {
+          current_.ForceWrite(address, value);
         }
 
+        int bank() { return bank_; }
+
+        // Points current_ at the bank the BankModeRegister now selects.
+        void Select();
+
       private:
-        // Unlike the RAM bank, the ROM bank number does not directly correspond
-        // to that banks index in the vector of banks. When the user sets the
-        // bottom 5 bits of the RAM/ROM bank register (the BankModeRegister here)
-        // to 0 it actually gets set to 1 since bank 0 is always mapped into
-        // memory at a different range of addresses. Thus we have to translate
-        // the given ROM bank number to its index in the vector.
-        unsigned char ComputeROMBank();
-
-        std::vector<ROMBank> banks_;
+        ROMImage* rom_;
         BankModeRegister* bank_mode_register_;
+        ROMBank current_;
+        int bank_ = 1;
     };
 
     class RAMBankN {
@@ -5,6 +5,7 @@
 
 #include "cc/backend/memory/mbc/internal_rom.h"
 #include "cc/backend/memory/mbc/mbc.h"
+#include "cc/backend/memory/mbc/rom_image.h"
 #include "cc/backend/memory/memory_segment.h"
 #include "cc/backend/memory/module.h"
 
@@ -13,8 +14,8 @@ namespace memory {
 
 class MBCWrapper : public MemorySegment {
  public:
-  void Init(unsigned char* program_rom, long size) {
-    mbc_ = ConstructMBC(program_rom, size);
+  void Init(std::shared_ptr<ROMImage> program_rom) {
+    mbc_ = ConstructMBC(program_rom);
   }
 
   unsigned char Read(unsigned short address) {
@@ -43,6 +44,16 @@ class MBCWrapper : public MemorySegment {
 
   bool InRange(unsigned short address) { return mbc_->InRange(address); }
 
+  int bank(unsigned short address) {
+    if (!internal_rom_flag_.is_set() && internal_rom_.InRange(address)) {
+      return kInternalROMBank;
+    } else {
+      return mbc_->bank(address);
+    }
+  }
+
+  static const int kInternalROMBank = -1;
+
   Flag* internal_rom_flag() { return &internal_rom_flag_; }
 
  private:
@@ -53,8 +64,8 @@ class MBCWrapper : public MemorySegment {
 
 class MBCModule : public Module {
  public:
-  void Init(unsigned char* program_rom, long size) {
-    mbc_.Init(program_rom, size);
+  void Init(std::shared_ptr<ROMImage> program_rom) {
+    mbc_.Init(program_rom);
     add_memory_segment(&mbc_);
     add_flag(internal_rom_flag());
   }
@@ -0,0 +1,75 @@
+#include "cc/backend/memory/mbc/rom_image.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "glog/logging.h"
+
+namespace backend {
+namespace memory {
+
+using std::shared_ptr;
+using std::string;
+
+const long ROMImage::kBankSize;
+const long ROMImage::kMinSize;
+
+shared_ptr<ROMImage> ROMImage::Map(const string& file_name) {
+  int file = open(file_name.c_str(), O_RDONLY);
+  if (file < 0) {
+    LOG(ERROR) << "Cannot open " << file_name << ": " << strerror(errno);
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(file, &file_stat) < 0) {
+    LOG(ERROR) << "Cannot stat " << file_name << ": " << strerror(errno);
+    close(file);
+    return nullptr;
+  }
+  long size = file_stat.st_size;
+
+  // Only whole pages of the file can be mapped, so a ROM which would need
+  // padding has to be read into memory of our own.
+  bool can_map = size >= kMinSize && size % kBankSize == 0;
+  void* data = mmap(nullptr, size, can_map ? PROT_READ | PROT_WRITE : PROT_READ,
+                    MAP_PRIVATE, file, 0);
+  close(file);
+  if (data == MAP_FAILED) {
+    LOG(ERROR) << "Cannot map " << file_name << ": " << strerror(errno);
+    return nullptr;
+  }
+  if (can_map) {
+    return shared_ptr<ROMImage>(new ROMImage(static_cast<unsigned char*>(data), size, true));
+  }
+  shared_ptr<ROMImage> image = Copy(static_cast<unsigned char*>(data), size);
+  munmap(data, size);
+  return image;
+}
+
+shared_ptr<ROMImage> ROMImage::Copy(const unsigned char* rom, long size) {
+  shared_ptr<ROMImage> image = Allocate(size);
+  memcpy(image->data(), rom, size);
+  return image;
+}
+
+shared_ptr<ROMImage> ROMImage::Allocate(long size) {
+  long padded_size = (size + kBankSize - 1) / kBankSize * kBankSize;
+  if (padded_size < kMinSize) {
+    padded_size = kMinSize;
+  }
+  return shared_ptr<ROMImage>(new ROMImage(new unsigned char[padded_size](), padded_size, false));
+}
+
+ROMImage::~ROMImage() {
+  if (is_mapped_) {
+    munmap(data_, size_);
+  } else {
+    delete[] data_;
+  }
+}
+
+} // namespace memory
+} // namespace backend
@@ -0,0 +1,52 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_MEMORY_MBC_ROM_IMAGE_H_
+#define TURBO_SANTA_COMMON_BACK_END_MEMORY_MBC_ROM_IMAGE_H_
+
+#include <memory>
+#include <string>
+
+namespace backend {
+namespace memory {
+
+// The program ROM of a cartridge, padded with zeros to a whole number of
+// banks, and at least two. The MBC's ROM banks are views into it, so the MBC
+// shares ownership of it.
+class ROMImage {
+ public:
+  // Maps the file privately: every emulator running the same ROM shares its
+  // pages, until a ForceWrite patches one and gets a copy of that page. Files
+  // which are not a whole number of banks are read instead. Returns nullptr if
+  // the file cannot be read.
+  static std::shared_ptr<ROMImage> Map(const std::string& file_name);
+
+  // Copies the first size bytes of rom.
+  static std::shared_ptr<ROMImage> Copy(const unsigned char* rom, long size);
+
+  // Allocates a zeroed image large enough for size bytes, which the caller
+  // fills in through data().
+  static std::shared_ptr<ROMImage> Allocate(long size);
+
+  ~ROMImage();
+
+  unsigned char* data() { return data_; }
+  long size() const { return size_; }
+
+  int bank_number() const { return size_ / kBankSize; }
+  unsigned char* bank(int bank) { return data_ + bank * kBankSize; }
+
+  static const long kBankSize = 0x4000;
+  static const long kMinSize = 2 * kBankSize;
+
+ private:
+  ROMImage(unsigned char* data, long size, bool is_mapped)
+      : data_(data), size_(size), is_mapped_(is_mapped) {}
+  ROMImage(const ROMImage&) = delete;
+  ROMImage& operator=(const ROMImage&) = delete;
+
+  unsigned char* const data_;
+  const long size_;
+  const bool is_mapped_;
+};
+
+} // namespace memory
+} // namespace backend
+#endif // TURBO_SANTA_COMMON_BACK_END_MEMORY_MBC_ROM_IMAGE_H_
@@ -24,8 +24,9 @@ using timer::TimerModule;
 Memory::Memory() = default;
 Memory::~Memory() = default;
 
-void Memory::Init(uint8_t* rom, size_t length, Screen* screen) {
+void Memory::Init(std::shared_ptr<ROMImage> rom, Screen* screen) {
   memory_mapper_ = unique_ptr<MemoryMapper>(new MemoryMapper());
+  memory_mapper_->set_scheduler(&scheduler_);
 
   unimplemented_module_ = unique_ptr<UnimplementedModule>(new UnimplementedModule());
   unimplemented_module_->Init();
@@ -40,7 +41,7 @@ void Memory::Init(uint8_t* rom, size_t length, Screen* screen) {
   memory_mapper_->RegisterModule(*default_module_);
 
   dma_transfer_module_ = unique_ptr<DMATransferModule>(new DMATransferModule());
-  dma_transfer_module_->Init(memory_mapper_.get());
+  dma_transfer_module_->Init(memory_mapper_.get(), &scheduler_);
   memory_mapper_->RegisterModule(*dma_transfer_module_);
 
   joypad_module_ = unique_ptr<JoypadModule>(new JoypadModule());
@@ -48,22 +49,17 @@ void Memory::Init(uint8_t* rom, size_t length, Screen* screen) {
   memory_mapper_->RegisterModule(*joypad_module_);
 
   timer_module_ = unique_ptr<TimerModule>(new TimerModule());
-  timer_module_->Init(primary_flags_->interrupt_flag());
+  timer_module_->Init(primary_flags_->interrupt_flag(), &scheduler_);
   memory_mapper_->RegisterModule(*timer_module_);
 
   mbc_module_ = unique_ptr<MBCModule>(new MBCModule());
-  mbc_module_->Init(rom, length);
+  mbc_module_->Init(rom);
   memory_mapper_->RegisterModule(*mbc_module_);
 
   graphics_controller_ = unique_ptr<GraphicsController>(new GraphicsController(screen, primary_flags_.get()));
-  graphics_controller_->Init();
+  graphics_controller_->Init(&scheduler_);
   memory_mapper_->RegisterModule(*graphics_controller_);
 }
 
-void Memory::Tick(int ticks) {
-  timer_module_->Tick(ticks);
-  graphics_controller_->Tick(ticks);
-}
-
 } // namespace memory
 } // namespace backend
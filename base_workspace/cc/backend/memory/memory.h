@@ -5,6 +5,8 @@
 #include <memory>
 #include "cc/backend/memory/joypad/joypad_module.h"
 #include "cc/backend/memory/mbc/mbc_module.h"
+#include "cc/backend/memory/mbc/rom_image.h"
+#include "cc/backend/scheduler/scheduler.h"
 
 namespace backend {
 namespace graphics {
@@ -34,9 +36,10 @@ class Memory {
   Memory();
   ~Memory();
 
-  void Init(uint8_t* rom, size_t length, graphics::Screen* screen);
+  void Init(std::shared_ptr<ROMImage> rom, graphics::Screen* screen);
 
-  void Tick(int ticks);
+  // Drives the timer and the graphics controller.
+  scheduler::Scheduler* scheduler() { return &scheduler_; }
 
   MemoryMapper* memory_mapper() { return memory_mapper_.get(); }
 
@@ -44,9 +47,12 @@ class Memory {
 
   PrimaryFlags* primary_flags() { return primary_flags_.get(); }
 
+  graphics::GraphicsController* graphics_controller() { return graphics_controller_.get(); }
+
   Flag* internal_rom_flag() { return mbc_module_->internal_rom_flag(); }
 
  private:
+  scheduler::Scheduler scheduler_;
   std::unique_ptr<MemoryMapper> memory_mapper_;
   std::unique_ptr<graphics::GraphicsController> graphics_controller_;
   std::unique_ptr<PrimaryFlags> primary_flags_;
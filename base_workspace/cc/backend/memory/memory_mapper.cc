@@ -1,4 +1,7 @@
 #include "cc/backend/memory/memory_mapper.h"
+
+#include <cstring>
+
 #include "cc/backend/debug/memory_profiler/memory_access.h"
 #include "glog/logging.h"
 
@@ -8,13 +11,13 @@ namespace memory {
 using std::vector;
 
 namespace {
-MemorySegment* Lookup(const vector<MemorySegment*>& segments, unsigned short address) {
+MemorySegment* FindSegment(const vector<MemorySegment*>& segments, unsigned short address) {
   for (MemorySegment* segment : segments) {
     if (segment->InRange(address)) {
       return segment;
     }
   }
-  LOG(FATAL) << "Address out of range: 0x" << std::hex << address;
+  return nullptr;
 }
 } // namespace
 
@@ -33,20 +36,151 @@ void MemoryMapper::RegisterModule(const Module& module) {
       flag_container_.add_flag(flag);
     }
   }
+
+  BuildPageTable();
+}
+
+// Resolves the owner of every address once, so that accesses never have to
+// scan memory_segments_. Segments registered earlier take precedence.
+void MemoryMapper::BuildPageTable() {
+  shared_pages_.clear();
+  shared_pages_.reserve(kPageNumber);
+  for (int page_number = 0; page_number < kPageNumber; page_number++) {
+    unsigned short page_start = page_number * kPageSize;
+    vector<MemorySegment*> owners(kPageSize);
+    bool is_shared = false;
+    for (int offset = 0; offset < kPageSize; offset++) {
+      owners[offset] = FindSegment(memory_segments_, page_start + offset);
+      // Point straight at the flag behind each I/O port, so that an access
+      // costs one virtual call instead of two.
+      if (owners[offset] == &flag_container_) {
+        owners[offset] = flag_container_.port(page_start + offset);
+      }
+      is_shared |= owners[offset] != owners[0];
+    }
+
+    Page& page = pages_[page_number];
+    bool watched = page.watched;
+    page = Page();
+    page.watched = watched;
+    if (is_shared) {
+      shared_pages_.push_back(owners);
+      page.segments = shared_pages_.back().data();
+    } else if (owners[0] != nullptr) {
+      page.segment = owners[0];
+      page.data = owners[0]->page(page_start);
+    }
+
+    Page& locked_page = locked_pages_[page_number];
+    if (page_number == kPageNumber - 1) {
+      locked_page = page;
+    } else {
+      locked_page = Page();
+      locked_page.segment = &open_bus_;
+      locked_page.watched = watched;
+    }
+  }
+}
+
+MemorySegment* MemoryMapper::Lookup(const Page& page, unsigned short address) {
+  MemorySegment* segment = page.segment;
+  if (page.segments != nullptr) {
+    segment = page.segments[address & 0xff];
+  }
+  if (segment == nullptr) {
+    LOG(FATAL) << "Address out of range: 0x" << std::hex << address;
+  }
+  return segment;
 }
 
 unsigned char MemoryMapper::Read(unsigned short address) {
-  PUBLISH_READ(address, Lookup(memory_segments_, address)->Read(address));
-  return Lookup(memory_segments_, address)->Read(address);
+  const Page& page = active_pages_[address >> 8];
+  unsigned char value;
+  if (page.data != nullptr) {
+    value = page.data[address & 0xff];
+  } else {
+    value = Lookup(page, address)->Read(address);
+  }
+  PUBLISH_READ(address, value, Bank(address), cycle());
+  return value;
+}
+
+unsigned char MemoryMapper::Peek(unsigned short address) {
+  const Page& page = pages_[address >> 8];
+  if (page.data != nullptr) {
+    return page.data[address & 0xff];
+  }
+  return Lookup(page, address)->Read(address);
 }
 
 void MemoryMapper::Write(unsigned short address, unsigned char value) {
-  PUBLISH_WRITE(address, Lookup(memory_segments_, address)->Read(address), value);
-  Lookup(memory_segments_, address)->Write(address, value);
+  const Page& page = active_pages_[address >> 8];
+  if (page.data != nullptr) {
+    PUBLISH_WRITE(address, page.data[address & 0xff], value, Bank(address), cycle());
+    page.data[address & 0xff] = value;
+  } else {
+    MemorySegment* segment = Lookup(page, address);
+    PUBLISH_WRITE(address, segment->Read(address), value, segment->bank(address), cycle());
+    segment->Write(address, value);
+  }
+  if (page.watched && write_watcher_ != nullptr) {
+    write_watcher_->Notify(address);
+  }
 }
 
 void MemoryMapper::ForceWrite(unsigned short address, unsigned char value) {
-  Lookup(memory_segments_, address)->ForceWrite(address, value);
+  const Page& page = pages_[address >> 8];
+  if (page.data != nullptr) {
+    page.data[address & 0xff] = value;
+  } else {
+    Lookup(page, address)->ForceWrite(address, value);
+  }
+  // ROM is never watched, since the CPU's writes there only select banks, so
+  // patches are reported whether or not the page is.
+  if (write_watcher_ != nullptr) {
+    write_watcher_->Notify(address);
+  }
+}
+
+// The backing storage of length bytes starting at address, if they all belong
+// to one segment which has it.
+unsigned char* MemoryMapper::Storage(unsigned short address, int length) {
+  const Page& page = pages_[address >> 8];
+  if (page.data != nullptr) {
+    return page.data + (address & 0xff);
+  }
+  MemorySegment* segment = Lookup(page, address);
+  if (!segment->InRange(address + length - 1)) {
+    return nullptr;
+  }
+  return segment->storage(address);
+}
+
+void MemoryMapper::Copy(unsigned short source, unsigned short destination, int length) {
+  unsigned char* from = Storage(source, length);
+  unsigned char* to = Storage(destination, length);
+  if (from != nullptr && to != nullptr) {
+    memcpy(to, from, length);
+  } else {
+    for (int i = 0; i < length; i++) {
+      const unsigned short from_address = source + i;
+      const unsigned short to_address = destination + i;
+      const unsigned char value = Lookup(pages_[from_address >> 8], from_address)->Read(from_address);
+      Lookup(pages_[to_address >> 8], to_address)->Write(to_address, value);
+    }
+  }
+  if (write_watcher_ != nullptr) {
+    for (int i = 0; i < length; i++) {
+      const unsigned short to_address = destination + i;
+      if (pages_[to_address >> 8].watched) {
+        write_watcher_->Notify(to_address);
+      }
+    }
+  }
+}
+
+int MemoryMapper::Bank(unsigned short address) {
+  return Lookup(pages_[address >> 8], address)->bank(address);
 }
 
 } // namespace memory
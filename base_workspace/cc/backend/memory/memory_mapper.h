@@ -7,26 +7,99 @@
 #include "cc/backend/memory/flag_container.h"
 #include "cc/backend/memory/memory_segment.h"
 #include "cc/backend/memory/module.h"
+#include "cc/backend/scheduler/scheduler.h"
 
 namespace test_harness {
 class TestHarness;
 } // namespace test_harness
 
 namespace backend {
+namespace opcode_executor {
+class InstructionCacheTest;
+} // namespace opcode_executor
+
 namespace memory {
 
+// Receives writes made to pages that have been watched with
+// MemoryMapper::Watch.
+class WriteWatcher {
+ public:
+  virtual void Notify(unsigned short address) = 0;
+};
+
 class MemoryMapper : public debug::Publisher {
  public:
   unsigned char Read(unsigned short address);
   void Write(unsigned short address, unsigned char value);
   void RegisterModule(const Module& module);
 
+  // Reads address as the CPU would see it, but without publishing the access;
+  // for the emulator's own look at memory, such as decoding instructions.
+  unsigned char Peek(unsigned short address);
+
+  // The bank currently mapped at this address by the segment which owns it.
+  int Bank(unsigned short address);
+
+  // Copies length bytes from source to destination the way OAM DMA does:
+  // without publishing the accesses, and with memcpy when both ranges have
+  // backing storage. Neither range may cross a page.
+  void Copy(unsigned short source, unsigned short destination, int length);
+
+  // While the bus is locked the CPU only reaches 0xff00-0xffff; everything
+  // else reads 0xff and ignores writes. Peek, ForceWrite, Bank and Copy are
+  // unaffected.
+  void set_bus_locked(bool locked) { active_pages_ = locked ? locked_pages_.data() : pages_.data(); }
+
+  // Reports all future writes to the page containing this address to the write
+  // watcher. Writes which patch memory the CPU cannot write, such as ROM, are
+  // always reported.
+  void Watch(unsigned short address) {
+    pages_[address >> 8].watched = true;
+    locked_pages_[address >> 8].watched = true;
+  }
+
+  void set_write_watcher(WriteWatcher* write_watcher) { write_watcher_ = write_watcher; }
+
+  // Published accesses are stamped with the scheduler's time.
+  void set_scheduler(const scheduler::Scheduler* scheduler) { scheduler_ = scheduler; }
+
+  uint64_t cycle() const { return scheduler_ == nullptr ? 0 : scheduler_->now(); }
+
+  static const int kPageSize = 0x100;
+  static const int kPageNumber = 0x100;
+
  private:
+  // One entry for each 256 byte page of the address space. A page is either
+  // plain memory, in which case data points at its bytes, owned entirely by
+  // one segment, or shared between several segments, in which case segments
+  // holds the owner of each address in the page.
+  struct Page {
+    unsigned char* data = nullptr;
+    MemorySegment* segment = nullptr;
+    MemorySegment** segments = nullptr;
+    bool watched = false;
+  };
+
+  // Writes value even where the CPU cannot, for test harnesses and debuggers.
   void ForceWrite(unsigned short address, unsigned char value);
+  void BuildPageTable();
+  MemorySegment* Lookup(const Page& page, unsigned short address);
+  unsigned char* Storage(unsigned short address, int length);
+
   FlagContainer flag_container_;
   std::vector<MemorySegment*> memory_segments_ = std::vector<MemorySegment*>(1, &flag_container_);
+  std::vector<Page> pages_ = std::vector<Page>(kPageNumber);
+  // The same as pages_, except that every page but the last is open bus.
+  std::vector<Page> locked_pages_ = std::vector<Page>(kPageNumber);
+  // Which of the two tables CPU reads and writes go through.
+  Page* active_pages_ = pages_.data();
+  OpenBusSegment open_bus_;
+  std::vector<std::vector<MemorySegment*>> shared_pages_;
+  WriteWatcher* write_watcher_ = nullptr;
+  const scheduler::Scheduler* scheduler_ = nullptr;
 
   friend test_harness::TestHarness;
+  friend opcode_executor::InstructionCacheTest;
 };
 
 } // namespace memory
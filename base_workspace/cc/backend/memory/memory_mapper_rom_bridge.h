@@ -44,6 +44,22 @@ class MemoryMapperHighRAMBridge : public decompiler::ROMBridge {
   const MemoryMapper& data_;
 };
 
+// Exposes the entire address space, as currently mapped. Reading through it
+// has no side effects and is not published.
+class MemoryMapperAddressSpaceBridge : public decompiler::ROMBridge {
+ public:
+  MemoryMapperAddressSpaceBridge(MemoryMapper* data) : data_(data) {}
+
+  uint8_t at(uint16_t address) const override { return data_->Peek(address); }
+
+  uint16_t min() const override { return 0x0000; }
+
+  uint16_t max() const override { return 0xffff; }
+
+ private:
+  MemoryMapper* data_;
+};
+
 } // namespace memory
 } // namespace backend
 
@@ -21,6 +21,18 @@ class MemorySegment {
   virtual void ForceWrite(unsigned short address, unsigned char value) {
     Write(address, value);
   }
+
+  // Backing storage for the 256 byte page containing this address, if reads
+  // and writes to the page have no side effects; otherwise nullptr.
+  virtual unsigned char* page(unsigned short) { return nullptr; }
+
+  // Backing storage from this address to the end of the segment, for segments
+  // which do not fill whole pages but can still be copied to directly.
+  virtual unsigned char* storage(unsigned short) { return nullptr; }
+
+  // Which bank is currently mapped at this address, for segments that switch
+  // between banks.
+  virtual int bank(unsigned short) { return 0; }
 };
 
 class ContiguousMemorySegment : public MemorySegment {
@@ -49,6 +61,15 @@ class SingleAddressSegment : public MemorySegment {
   unsigned short address_;
 };
 
+// What the CPU sees of memory it is cut off from, such as everything outside
+// of 0xff00-0xffff during OAM DMA: reads return 0xff and writes are lost.
+class OpenBusSegment : public MemorySegment {
+ public:
+  virtual bool InRange(unsigned short) { return false; }
+  virtual unsigned char Read(unsigned short) { return 0xff; }
+  virtual void Write(unsigned short, unsigned char) {}
+};
+
 // For memory segments that we have not written yet.
 class NullMemorySegment : public ContiguousMemorySegment {
  public:
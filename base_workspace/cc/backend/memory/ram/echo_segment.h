@@ -33,6 +33,15 @@ class EchoSegment : public ContiguousMemorySegment {
     }
   }
 
+  virtual unsigned char* page(unsigned short address) {
+    if (internal_ram_0_->InRange(translate_address(address))) {
+      return internal_ram_0_->page(translate_address(address));
+    } else if (internal_ram_1_->InRange(translate_address(address))) {
+      return internal_ram_1_->page(translate_address(address));
+    }
+    return nullptr;
+  }
+
  protected:
   virtual unsigned short lower_address_bound() { return 0xe000; }
   virtual unsigned short upper_address_bound() { return 0xfdff; }
@@ -21,6 +21,14 @@ class RAMSegment : public ContiguousMemorySegment {
     memory_[address - lower_address_bound_] = value;
   }
 
+  virtual unsigned char* page(unsigned short address) {
+    unsigned short page_start = address & 0xff00;
+    if (page_start < lower_address_bound_ || page_start + 0xff > upper_address_bound_) {
+      return nullptr;
+    }
+    return memory_.data() + (page_start - lower_address_bound_);
+  }
+
  protected:
   unsigned short lower_address_bound_;
   unsigned short upper_address_bound_;
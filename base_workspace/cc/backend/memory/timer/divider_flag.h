@@ -3,29 +3,32 @@
 
 #include <cstdint>
 #include "cc/backend/memory/flags.h"
-#include "glog/logging.h"
+#include "cc/backend/scheduler/scheduler.h"
 
 namespace backend {
 namespace memory {
 namespace timer {
 
+// The divider is computed from the clock when it is read, so it never needs to
+// be ticked.
 class DividerFlag : public Flag {
  public:
   DividerFlag() : Flag(0xff04) {}
 
-  void Write(uint16_t, uint8_t) override { set_flag(0); }
+  void set_scheduler(scheduler::Scheduler* scheduler) { scheduler_ = scheduler; }
 
-  void Tick(int ticks) {
-    ticks_ += ticks;
-    if (ticks >= kTicksToIncrement) {
-      set_flag(flag() + 1);
-      ticks_ = 0;
-    }
+  uint8_t Read(uint16_t) override { return flag(); }
+
+  void Write(uint16_t, uint8_t) override { reset_time_ = scheduler_->now(); }
+
+  uint8_t flag() override {
+    return static_cast<uint8_t>((scheduler_->now() - reset_time_) / kTicksToIncrement);
   }
 
  private:
   static const int kTicksToIncrement = 256;
-  int ticks_ = 0;
+  scheduler::Scheduler* scheduler_ = nullptr;
+  uint64_t reset_time_ = 0;
 };
 
 } // namespace timer
@@ -7,6 +7,7 @@
 #include "cc/backend/memory/interrupt/interrupt_flag.h"
 #include "cc/backend/memory/module.h"
 #include "cc/backend/memory/timer/divider_flag.h"
+#include "cc/backend/scheduler/scheduler.h"
 #include "glog/logging.h"
 
 namespace backend {
@@ -32,7 +33,7 @@ class TimerControlFlag : public Flag {
         return k262144Hz;
       case 2:
         return k65536Hz;
-      case 4:
+      case 3:
         return k16384Hz;
       default:
         LOG(FATAL) << "Invalid timer speed.";
@@ -44,40 +45,97 @@ class TimerControlFlag : public Flag {
   }
 };
 
+// The counter is only brought up to date when it is accessed or when it
+// overflows; the overflow is registered with the scheduler.
 class TimerModule : public Module {
  public:
-  void Init(InterruptFlag* interrupt_flag) {
+  void Init(InterruptFlag* interrupt_flag, scheduler::Scheduler* scheduler) {
     interrupt_flag_ = interrupt_flag;
+    scheduler_ = scheduler;
+    divider_flag_.set_scheduler(scheduler);
     add_flag(&divider_flag_);
     add_flag(&timer_counter_);
     add_flag(&timer_modulo_);
     add_flag(&timer_control_);
   }
 
-  void Tick(int ticks) {
-    divider_flag_.Tick(ticks);
+ private:
+  class TimerCounterFlag : public Flag {
+   public:
+    TimerCounterFlag(TimerModule* timer_module) : Flag(0xff05), timer_module_(timer_module) {}
+
+    uint8_t Read(uint16_t address) override {
+      timer_module_->CatchUp();
+      return Flag::Read(address);
+    }
+
+    void Write(uint16_t address, uint8_t value) override {
+      timer_module_->CatchUp();
+      Flag::Write(address, value);
+      timer_module_->ScheduleOverflow();
+    }
+
+   private:
+    TimerModule* timer_module_;
+  };
+
+  class SyncedTimerControlFlag : public TimerControlFlag {
+   public:
+    SyncedTimerControlFlag(TimerModule* timer_module) : timer_module_(timer_module) {}
+
+    void Write(uint16_t address, uint8_t value) override {
+      timer_module_->CatchUp();
+      TimerControlFlag::Write(address, value);
+      timer_module_->ScheduleOverflow();
+    }
+
+   private:
+    TimerModule* timer_module_;
+  };
+
+  // Applies every increment which should have happened by now.
+  void CatchUp() {
+    uint64_t now = scheduler_->now();
     if (!timer_control_.is_timer_running()) {
+      last_increment_ = now;
       return;
     }
 
-    ticks_ += ticks;
-    if (ticks_ >= ticks_to_increment()) {
-      if (timer_counter_.flag() == 0xff) {
-        timer_counter_.set_flag(timer_modulo_.flag());
-        interrupt_flag_->set_timer(true);
-      } else {
-        timer_counter_.set_flag(timer_counter_.flag() + 1);
+    uint64_t increments = (now - last_increment_) / ticks_to_increment();
+    last_increment_ += increments * ticks_to_increment();
+    while (increments > 0) {
+      unsigned int increments_to_overflow = 0x100 - timer_counter_.flag();
+      if (increments < increments_to_overflow) {
+        timer_counter_.set_flag(timer_counter_.flag() + increments);
+        return;
       }
+      increments -= increments_to_overflow;
+      timer_counter_.set_flag(timer_modulo_.flag());
+      interrupt_flag_->set_timer(true);
     }
   }
 
- private:
-  int ticks_ = 0;
+  void ScheduleOverflow() {
+    if (!timer_control_.is_timer_running()) {
+      scheduler_->Cancel(&overflow_event_);
+      return;
+    }
+    uint64_t increments_to_overflow = 0x100 - timer_counter_.flag();
+    scheduler_->Schedule(&overflow_event_,
+                         last_increment_ + increments_to_overflow * ticks_to_increment());
+  }
+
   InterruptFlag* interrupt_flag_;
-  Flag timer_counter_ = Flag(0xff05);
+  scheduler::Scheduler* scheduler_;
+  uint64_t last_increment_ = 0;
+  TimerCounterFlag timer_counter_ = TimerCounterFlag(this);
   Flag timer_modulo_ = Flag(0xff06);
-  TimerControlFlag timer_control_;
+  SyncedTimerControlFlag timer_control_ = SyncedTimerControlFlag(this);
   DividerFlag divider_flag_;
+  scheduler::Event overflow_event_ = scheduler::Event([this](uint64_t) {
+    CatchUp();
+    ScheduleOverflow();
+  }, "timer");
 
   int ticks_to_increment() { return 4194304 / timer_control_.timer_speed(); }
 };
@@ -34,6 +34,9 @@ struct ExecutorContext {
   uint16_t* instruction_ptr;
   memory::MemoryMapper* memory_mapper;
   registers::GB_CPU* cpu;
+  // Cycles the instruction took beyond its clock_cycles, which are those of a
+  // conditional jump, call or return that is not taken.
+  int extra_cycles = 0;
 };
 
 } // namespace opcode_executor
@@ -0,0 +1,130 @@
+#include "cc/backend/opcode_executor/instruction_cache.h"
+
+#include "cc/backend/memory/mbc/mbc_module.h"
+#include "cc/backend/memory/memory_layout.h"
+
+namespace backend {
+namespace opcode_executor {
+
+using decompiler::Instruction;
+
+namespace {
+
+// Echo RAM repeats work RAM from 0xc000 up to 0xddff.
+const int kEchoOffset = memory::kECHOMin - memory::kWRAMBank0Min;
+
+// The entry at index of the bank, allocating the bank if asked to.
+template <typename Entry>
+Entry* FindInBank(std::vector<std::vector<Entry>>* banks,
+                  size_t bank,
+                  int bank_size,
+                  int index,
+                  bool allocate) {
+  if (bank >= banks->size()) {
+    if (!allocate) {
+      return nullptr;
+    }
+    banks->resize(bank + 1);
+  }
+  std::vector<Entry>& entries = (*banks)[bank];
+  if (entries.empty()) {
+    if (!allocate) {
+      return nullptr;
+    }
+    entries.resize(bank_size);
+  }
+  return &entries[index];
+}
+
+// Which part of the address space, of those that are banked independently of
+// each other, address belongs to.
+int BankedRegion(uint16_t address) {
+  if (address <= memory::kROMBank0Max) {
+    return 0;
+  } else if (address <= memory::kROMBankNMax) {
+    return 1;
+  } else if (address < memory::kExternalRAMMin) {
+    return 2;
+  } else if (address <= memory::kExternalRAMMax) {
+    return 3;
+  }
+  return 4;
+}
+
+bool IsMirroredWorkRAM(uint16_t address) {
+  return memory::kWRAMBank0Min <= address && address <= memory::kECHOMax - kEchoOffset;
+}
+
+} // namespace
+
+InstructionCache::InstructionCache(memory::MemoryMapper* memory_mapper) :
+    memory_mapper_(memory_mapper), bridge_(memory_mapper), rom_reader_(bridge_) {
+  memory_mapper_->set_write_watcher(this);
+}
+
+InstructionCache::Entry* InstructionCache::Find(uint16_t address, bool allocate) {
+  if (address <= memory::kROMBankNMax) {
+    size_t bank = memory_mapper_->Bank(address) - memory::MBCWrapper::kInternalROMBank;
+    return FindInBank(&rom_banks_, bank, kROMBankSize, address % kROMBankSize, allocate);
+  }
+  if (memory::kExternalRAMMin <= address && address <= memory::kExternalRAMMax) {
+    return FindInBank(&cartridge_ram_banks_, memory_mapper_->Bank(address), kCartridgeRAMBankSize,
+                      address - memory::kExternalRAMMin, allocate);
+  }
+
+  if (memory::kECHOMin <= address && address <= memory::kECHOMax) {
+    address -= kEchoOffset;
+  }
+  if (ram_.empty()) {
+    if (!allocate) {
+      return nullptr;
+    }
+    ram_.resize(kRAMSize);
+  }
+  return &ram_[address - memory::kVRAMMin];
+}
+
+void InstructionCache::Watch(uint16_t address) {
+  if (address <= memory::kROMBankNMax) {
+    return;
+  }
+  memory_mapper_->Watch(address);
+  if (IsMirroredWorkRAM(address)) {
+    memory_mapper_->Watch(address + kEchoOffset);
+  } else if (memory::kECHOMin <= address && address <= memory::kECHOMax) {
+    memory_mapper_->Watch(address - kEchoOffset);
+  }
+}
+
+const Instruction* InstructionCache::Fetch(uint16_t address) {
+  Entry* entry = Find(address, true);
+  if (!entry->decoded) {
+    if (!rom_reader_.Read(address, &entry->instruction)) {
+      return nullptr;
+    }
+    const uint16_t last = address + entry->instruction.instruction_width_bytes - 1;
+    if (BankedRegion(last) != BankedRegion(address)) {
+      // Its entry is only looked up by the bank of its first byte, so a switch
+      // of the bank holding the rest would go unnoticed; it is left undecoded.
+      return &entry->instruction;
+    }
+    entry->decoded = true;
+    // An instruction may straddle two pages.
+    Watch(address);
+    Watch(last);
+  }
+  return &entry->instruction;
+}
+
+void InstructionCache::Notify(unsigned short address) {
+  // Drop every instruction which could include this byte.
+  for (int i = 0; i < kMaxInstructionWidth && i <= address; i++) {
+    Entry* entry = Find(address - i, false);
+    if (entry != nullptr) {
+      entry->decoded = false;
+    }
+  }
+}
+
+} // namespace opcode_executor
+} // namespace backend
@@ -0,0 +1,61 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_OPCODE_EXECUTOR_INSTRUCTION_CACHE_H_
+#define TURBO_SANTA_COMMON_BACK_END_OPCODE_EXECUTOR_INSTRUCTION_CACHE_H_
+
+#include <cstdint>
+#include <vector>
+#include "cc/backend/decompiler/instruction.h"
+#include "cc/backend/decompiler/rom_reader.h"
+#include "cc/backend/memory/memory_mapper.h"
+#include "cc/backend/memory/memory_mapper_rom_bridge.h"
+
+namespace backend {
+namespace opcode_executor {
+
+// Decodes instructions the first time they are executed and keeps them in flat
+// arrays indexed by address: one array for each ROM bank, one for each
+// cartridge RAM bank and one for the rest of the address space, in which echo
+// RAM shares the entries of the work RAM it mirrors. Entries are dropped when
+// the memory they were decoded from is written to; a bank switch selects a
+// different array. Instructions which span two independently banked regions
+// are decoded again each time they are fetched. Decoding reads memory
+// without side effects. ROM is not watched, since writes there only select
+// banks, but the MemoryMapper reports patches to it all the same.
+class InstructionCache : public memory::WriteWatcher {
+ public:
+  InstructionCache(memory::MemoryMapper* memory_mapper);
+
+  // Returns nullptr if there is no valid instruction at this address. The
+  // instruction remains valid until the next call to Fetch.
+  const decompiler::Instruction* Fetch(uint16_t address);
+
+  void Notify(unsigned short address) override;
+
+ private:
+  struct Entry {
+    bool decoded = false;
+    decompiler::Instruction instruction;
+  };
+
+  static const int kROMBankSize = 0x4000;
+  static const int kCartridgeRAMBankSize = 0x2000;
+  static const int kRAMSize = 0x8000;
+  static const int kMaxInstructionWidth = 3;
+
+  Entry* Find(uint16_t address, bool allocate);
+  // Watches the page containing address and, for work RAM, its echo.
+  void Watch(uint16_t address);
+
+  memory::MemoryMapper* memory_mapper_;
+  memory::MemoryMapperAddressSpaceBridge bridge_;
+  decompiler::ROMReader rom_reader_;
+  // Indexed by bank number + 1 so that the internal ROM comes first.
+  std::vector<std::vector<Entry>> rom_banks_;
+  // Indexed by bank number.
+  std::vector<std::vector<Entry>> cartridge_ram_banks_;
+  std::vector<Entry> ram_;
+};
+
+} // namespace opcode_executor
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_OPCODE_EXECUTOR_INSTRUCTION_CACHE_H_
@@ -0,0 +1,105 @@
+#include "cc/backend/opcode_executor/instruction_cache.h"
+
+#include <memory>
+
+#include "cc/backend/memory/mbc/mbc_module.h"
+#include "cc/backend/memory/mbc/rom_image.h"
+#include "cc/backend/memory/memory_mapper.h"
+#include "cc/backend/memory/ram/default_module.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace opcode_executor {
+
+using memory::DefaultModule;
+using memory::MBCModule;
+using memory::MemoryMapper;
+using memory::ROMImage;
+
+namespace {
+
+const unsigned char kNOP = 0x00;
+const unsigned char kIncA = 0x3c;
+const unsigned char kIncB = 0x04;
+const unsigned char kLoadA = 0x3e;
+
+} // namespace
+
+class InstructionCacheTest : public ::testing::Test {
+ protected:
+  // An MBC1 cartridge with four banks of ROM and four banks of RAM. The last
+  // byte of bank 0 starts a load whose operand is the first byte of the
+  // switchable bank, which holds that bank's number.
+  InstructionCacheTest() : rom_(ROMImage::Allocate(0x10000)) {
+    rom_->data()[0x147] = 0x03;
+    rom_->data()[0x148] = 0x01;
+    rom_->data()[0x149] = 0x03;
+    rom_->bank(0)[0x3fff] = kLoadA;
+    for (int bank = 1; bank < 4; bank++) {
+      rom_->bank(bank)[0] = bank;
+    }
+    default_module_.Init();
+    memory_mapper_.RegisterModule(default_module_);
+    mbc_module_.Init(rom_);
+    memory_mapper_.RegisterModule(mbc_module_);
+    cache_ = std::unique_ptr<InstructionCache>(new InstructionCache(&memory_mapper_));
+  }
+
+  uint16_t Fetch(uint16_t address) { return cache_->Fetch(address)->instruction; }
+
+  void Patch(uint16_t address, unsigned char value) { memory_mapper_.ForceWrite(address, value); }
+
+  std::shared_ptr<ROMImage> rom_;
+  MemoryMapper memory_mapper_;
+  DefaultModule default_module_;
+  MBCModule mbc_module_;
+  std::unique_ptr<InstructionCache> cache_;
+};
+
+TEST_F(InstructionCacheTest, EchoRAMSharesWorkRAMInstructions) {
+  memory_mapper_.Write(0xc000, kNOP);
+  EXPECT_EQ(kNOP, Fetch(0xe000));
+
+  memory_mapper_.Write(0xc000, kIncA);
+  EXPECT_EQ(kIncA, Fetch(0xe000));
+  EXPECT_EQ(kIncA, Fetch(0xc000));
+
+  memory_mapper_.Write(0xe000, kIncB);
+  EXPECT_EQ(kIncB, Fetch(0xc000));
+}
+
+TEST_F(InstructionCacheTest, CartridgeRAMBanksAreCachedSeparately) {
+  // RAM banking mode, bank 0.
+  memory_mapper_.Write(0x6000, 0x01);
+  memory_mapper_.Write(0x4000, 0x00);
+  memory_mapper_.Write(0xa000, kIncA);
+  EXPECT_EQ(kIncA, Fetch(0xa000));
+
+  memory_mapper_.Write(0x4000, 0x01);
+  memory_mapper_.Write(0xa000, kIncB);
+  EXPECT_EQ(kIncB, Fetch(0xa000));
+
+  memory_mapper_.Write(0x4000, 0x00);
+  EXPECT_EQ(kIncA, Fetch(0xa000));
+}
+
+TEST_F(InstructionCacheTest, ROMPatchesInvalidateInstructions) {
+  EXPECT_EQ(kNOP, Fetch(0x0150));
+  Patch(0x0150, kIncA);
+  EXPECT_EQ(kIncA, Fetch(0x0150));
+
+  EXPECT_EQ(kNOP, Fetch(0x4001));
+  Patch(0x4001, kIncB);
+  EXPECT_EQ(kIncB, Fetch(0x4001));
+}
+
+TEST_F(InstructionCacheTest, InstructionsAcrossROMBanksFollowTheSwitchableBank) {
+  memory_mapper_.Write(0x2000, 0x01);
+  EXPECT_EQ(1, cache_->Fetch(0x3fff)->arg2.value.val);
+
+  memory_mapper_.Write(0x2000, 0x02);
+  EXPECT_EQ(2, cache_->Fetch(0x3fff)->arg2.value.val);
+}
+
+} // namespace opcode_executor
+} // namespace backend
@@ -1,9 +1,9 @@
 #include "cc/backend/opcode_executor/opcode_executor.h"
 
-#include "cc/backend/decompiler/decompiler.h"
-#include "cc/backend/decompiler/decompiler_factory.h"
+#include "cc/backend/debug/access_record.h"
+#include "cc/backend/debug/diagnostics.h"
+#include "cc/backend/debug/instrumentation.h"
 #include "cc/backend/decompiler/instruction.h"
-#include "cc/backend/decompiler/rom_reader.h"
 #include "cc/backend/opcode_executor/opcode_handlers.h"
 #include "glog/logging.h"
 
@@ -12,21 +12,17 @@ namespace opcode_executor {
 
 using opcodes::Opcode;
 using decompiler::ArgumentType;
-using decompiler::DecompilerFactory;
 using decompiler::Instruction;
 using decompiler::Parameter;
 using decompiler::Register;
-using decompiler::ROMReader;
 using registers::GB_CPU;
 
 OpcodeExecutor::OpcodeExecutor(memory::MemoryMapper* memory_mapper, 
-                               memory::PrimaryFlags* primary_flags,
-                               memory::Flag* internal_rom_flag) : 
+                               memory::PrimaryFlags* primary_flags) : 
     memory_mapper_(memory_mapper),
-    opcode_parser_(*memory_mapper_),
+    opcode_parser_(memory_mapper_),
     interrupt_enable_(primary_flags->interrupt_enable()),
-    interrupt_flag_(primary_flags->interrupt_flag()), 
-    internal_rom_flag_(internal_rom_flag) {
+    interrupt_flag_(primary_flags->interrupt_flag()) {
   cpu_.rPC = 0;
 }
 
@@ -35,29 +31,37 @@ OpcodeExecutor::~OpcodeExecutor() = default;
 int OpcodeExecutor::ReadInstruction() {
   HandleInterrupts();
   if (halted_) {
-    // We need to use some number of clock cycles while halted.
-    return 4;
-  }
-
-  LOG(INFO) << "Current address: 0x" << std::hex << cpu_.rPC;
-
-  if (using_internal_rom_ && internal_rom_flag_->flag()) {
-    SwitchToExternalROM();
-    LOG(INFO) << "Switched to external ROM.";
-    using_internal_rom_ = false;
+    if (!CheckInterrupts()) {
+      // We need to use some number of clock cycles while halted.
+      return 4;
+    }
+    // HALT ends once an enabled interrupt is requested, even if IME is off and
+    // the interrupt will not be serviced.
+    halted_ = false;
   }
 
-  Instruction instruction;
-  if (!opcode_parser_.FetchInstruction(cpu_.rPC,
-                                       PollRegister(memory_mapper_, cpu_.rSP),
-                                       cpu_.rHL,
-                                       &instruction)) {
+  const Instruction* fetched = opcode_parser_.FetchInstruction(cpu_.rPC);
+  if (fetched == nullptr) {
     LOG(WARNING) << "Invalid address, 0x" << std::hex << cpu_.rPC 
         << ", exiting with error.";
     return -1;
   }
+  const Instruction& instruction = *fetched;
+  DIAGNOSE(2, CPU, "Executing 0x%x at 0x%x", instruction.instruction, cpu_.rPC);
+  if (debug::Instrumentation::enabled(debug::Instrumentation::OPCODE_EXECUTOR) &&
+      memory_mapper_->Interested(debug::AccessRecord::INSTRUCTION, cpu_.rPC)) {
+    // Published through the memory mapper so that the instruction lands in
+    // the same batch as, and just before, the accesses it makes.
+    memory_mapper_->PublishRecord(debug::AccessRecord::Instruction(
+        cpu_.rPC, instruction.instruction, memory_mapper_->Bank(cpu_.rPC), memory_mapper_->cycle()));
+  }
   cpu_.rPC += instruction.instruction_width_bytes;
-  OpcodeHandler handler = opcode_map_[instruction.instruction];
+  OpcodeHandlerFunction handler = LookUpOpcodeHandler(instruction.instruction);
+  if (handler == nullptr) {
+    LOG(WARNING) << "Unknown instruction, 0x" << std::hex << instruction.instruction
+        << ", exiting with error.";
+    return -1;
+  }
 
   ExecutorContext context;
   context.instruction_ptr = &cpu_.rPC;
@@ -71,7 +75,7 @@ int OpcodeExecutor::ReadInstruction() {
     return -1;
   } else {
     cpu_.rPC = static_cast<uint16_t>(handler_result);
-    return instruction.clock_cycles;
+    return instruction.clock_cycles + context.extra_cycles;
   }
 }
 
@@ -80,32 +84,28 @@ int OpcodeExecutor::ReadInstruction() {
 // 3) Push PC (as if CALL was performed), set PC to interrupt address, disable IME
 void OpcodeExecutor::HandleInterrupts() {
   if (interrupt_master_enable_ && CheckInterrupts()) {
-    // TODO(Brendan): Find a better solution to interrupts durring a DMA transfer.
-    if (opcode_parser_.is_dma_running()) {
-      return;
-    }
     interrupt_master_enable_ = false;
     halted_ = false;
     PushRegister(memory_mapper_, &cpu_, &cpu_.rPC);
 
     if (interrupt_flag_->v_blank() && interrupt_enable_->v_blank()) {
-      LOG(INFO) << "Handling V blank interrupt.";
+      DIAGNOSE(1, INTERRUPTS, "Handling V blank interrupt.");
       interrupt_flag_->set_v_blank(false);
       cpu_.rPC = 0x0040;
     } else if (interrupt_flag_->lcd_stat() && interrupt_enable_->lcd_stat()) {
-      LOG(INFO) << "Handling LCD stat interrupt.";
+      DIAGNOSE(1, INTERRUPTS, "Handling LCD stat interrupt.");
       interrupt_flag_->set_lcd_stat(false);
       cpu_.rPC = 0x0048;
     } else if (interrupt_flag_->timer() && interrupt_enable_->timer()) {
-      LOG(INFO) << "Handling timer interrupt.";
+      DIAGNOSE(1, INTERRUPTS, "Handling timer interrupt.");
       interrupt_flag_->set_timer(false);
       cpu_.rPC = 0x0050;
     } else if (interrupt_flag_->serial() && interrupt_enable_->serial()) {
-      LOG(INFO) << "Handling serial interrupt.";
+      DIAGNOSE(1, INTERRUPTS, "Handling serial interrupt.");
       interrupt_flag_->set_serial(false);
       cpu_.rPC = 0x0058;
     } else if (interrupt_flag_->joypad() && interrupt_enable_->joypad()) {
-      LOG(INFO) << "Handling joypad interrupt.";
+      DIAGNOSE(1, INTERRUPTS, "Handling joypad interrupt.");
       interrupt_flag_->set_joypad(false);
       cpu_.rPC = 0x0060;
     }
@@ -1,11 +1,9 @@
 #ifndef TURBO_SANTA_COMMON_BACK_END_OPCODE_EXECUTOR_OPCODE_EXECUTOR_H_
 #define TURBO_SANTA_COMMON_BACK_END_OPCODE_EXECUTOR_OPCODE_EXECUTOR_H_
 
-#include <map>
 #include <memory>
 #include "cc/backend/memory/interrupt/interrupt_flag.h"
 #include "cc/backend/memory/memory_mapper.h"
-#include "cc/backend/memory/memory_mapper_rom_bridge.h"
 #include "cc/backend/memory/interrupt/primary_flags.h"
 #include "cc/backend/opcode_executor/executor_context.h"
 #include "cc/backend/opcode_executor/opcodes.h"
@@ -13,45 +11,38 @@
 #include "cc/backend/opcode_executor/opcode_parser.h"
 #include "cc/backend/opcode_executor/registers.h"
 
-namespace backend {
-namespace decompiler {
-class Decompiler;
-class ROMReader;
-} // namespace decompiler
-} // namespace backend
-
 namespace backend {
 namespace opcode_executor {
 
 class OpcodeExecutor {
  public:
   OpcodeExecutor(memory::MemoryMapper* memory_mapper, 
-                 memory::PrimaryFlags* primary_flags,
-                 memory::Flag* internal_rom_flag);
+                 memory::PrimaryFlags* primary_flags);
 
   ~OpcodeExecutor();
 
-  void Init() { opcode_parser_.Init(); }
-
   int ReadInstruction();
 
+  // True while the CPU is waiting in HALT for an enabled interrupt.
+  bool halted() const { return halted_; }
+
+  // True if an interrupt which IE enables has been requested in IF, which
+  // ends HALT whether or not IME is set.
+  bool interrupt_pending() { return CheckInterrupts(); }
+
  private:
   bool CheckInterrupts();
   void HandleInterrupts();
-  void SwitchToExternalROM() { opcode_parser_.Reset(); }
     
   registers::GB_CPU cpu_;
   memory::MemoryMapper* memory_mapper_;
   OpcodeParser opcode_parser_;
-  std::map<uint16_t, OpcodeHandler> opcode_map_ = CreateOpcodeMap();
   // This is a special flag/register that can only be set or unset and can
   // only be accessed by the user using the EI, DI or RETI instructions.
   bool interrupt_master_enable_ = false;
   bool halted_ = false;
-  bool using_internal_rom_ = true;
   memory::InterruptEnable* interrupt_enable_;
   memory::InterruptFlag* interrupt_flag_;
-  memory::Flag* internal_rom_flag_;
 
   friend test_harness::TestHarness;
 };
@@ -1,5 +1,6 @@
 #include "cc/backend/opcode_executor/opcode_handlers.h"
 
+#include "cc/backend/debug/diagnostics.h"
 #include "cc/backend/opcode_executor/opcodes.h"
 #include "glog/logging.h"
 
@@ -15,6 +16,16 @@ using registers::GB_CPU;
 using memory::MemoryMapper;
 using std::string;
 
+namespace {
+
+// What a conditional jump, call or return costs on top of its clock_cycles
+// when it is taken.
+const int kTakenJumpCycles = 4;
+const int kTakenCallCycles = 12;
+const int kTakenReturnCycles = 12;
+
+} // namespace
+
 uint16_t* GetRegister16Bit(Register reg, GB_CPU* cpu) {
   switch (reg) {
     case Register::A:
@@ -541,10 +552,9 @@ int Cp8Bit(const decompiler::Instruction& instruction, ExecutorContext* context)
   context->cpu->flag_struct.rF.H = !DoesHalfBorrow8(context->cpu->flag_struct.rA, arg2);
   context->cpu->flag_struct.rF.C = !DoesBorrow8(context->cpu->flag_struct.rA, arg2);
   // PrintInstruction(context->frame_factory, "CP", "A", RegisterName8(opcode->reg1, context->cpu));
-  LOG(INFO) << "Z flag = " << 0x0000 + context->cpu->flag_struct.rF.Z;
-  LOG(INFO) << "N flag = " << 0x0000 + context->cpu->flag_struct.rF.N;
-  LOG(INFO) << "H flag = " << 0x0000 + context->cpu->flag_struct.rF.H;
-  LOG(INFO) << "C flag = " << 0x0000 + context->cpu->flag_struct.rF.C;
+  DIAGNOSE(2, CPU, "Compared, Z = %d N = %d H = %d C = %d", context->cpu->flag_struct.rF.Z,
+           context->cpu->flag_struct.rF.N, context->cpu->flag_struct.rF.H,
+           context->cpu->flag_struct.rF.C);
   return instruction_ptr;
 }
 
@@ -557,10 +567,9 @@ int Cp8BitAddress(const decompiler::Instruction& instruction, ExecutorContext* c
   context->cpu->flag_struct.rF.H = !DoesHalfBorrow8(context->cpu->flag_struct.rA, value);
   context->cpu->flag_struct.rF.C = !DoesBorrow8(context->cpu->flag_struct.rA, value);
   // PrintInstruction(context->frame_factory, "CP", "A", "(" + RegisterName16(opcode->reg1, context->cpu) + ")");
-  LOG(INFO) << "Z flag = " << 0x0000 + context->cpu->flag_struct.rF.Z;
-  LOG(INFO) << "N flag = " << 0x0000 + context->cpu->flag_struct.rF.N;
-  LOG(INFO) << "H flag = " << 0x0000 + context->cpu->flag_struct.rF.H;
-  LOG(INFO) << "C flag = " << 0x0000 + context->cpu->flag_struct.rF.C;
+  DIAGNOSE(2, CPU, "Compared, Z = %d N = %d H = %d C = %d", context->cpu->flag_struct.rF.Z,
+           context->cpu->flag_struct.rF.N, context->cpu->flag_struct.rF.H,
+           context->cpu->flag_struct.rF.C);
   return instruction_ptr;
 }
   
@@ -574,10 +583,9 @@ int Cp8BitLiteral(const decompiler::Instruction& instruction, ExecutorContext* c
   context->cpu->flag_struct.rF.H = !DoesHalfBorrow8(context->cpu->flag_struct.rA, value);
   context->cpu->flag_struct.rF.C = !DoesBorrow8(context->cpu->flag_struct.rA, value);
   // PrintInstruction(context->frame_factory, "CP", "A", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
-  LOG(INFO) << "Z flag = " << 0x0000 + context->cpu->flag_struct.rF.Z;
-  LOG(INFO) << "N flag = " << 0x0000 + context->cpu->flag_struct.rF.N;
-  LOG(INFO) << "H flag = " << 0x0000 + context->cpu->flag_struct.rF.H;
-  LOG(INFO) << "C flag = " << 0x0000 + context->cpu->flag_struct.rF.C;
+  DIAGNOSE(2, CPU, "Compared, Z = %d N = %d H = %d C = %d", context->cpu->flag_struct.rF.Z,
+           context->cpu->flag_struct.rF.N, context->cpu->flag_struct.rF.H,
+           context->cpu->flag_struct.rF.C);
   return instruction_ptr;
 }
 
@@ -762,7 +770,7 @@ int NOP(const decompiler::Instruction&, ExecutorContext* context) {
 
 int Halt(const decompiler::Instruction&, ExecutorContext* context) {
   int instruction_ptr = *context->instruction_ptr;
-  LOG(INFO) << "Halting.";
+  DIAGNOSE(1, CPU, "Halting.");
   *context->halted = true;
   // PrintInstruction(context->frame_factory, "HALT");
   return instruction_ptr;
@@ -779,7 +787,7 @@ int Stop(const decompiler::Instruction&, ExecutorContext* context) {
 int DI(const decompiler::Instruction&, ExecutorContext* context) {
   int instruction_ptr = *context->instruction_ptr;
   *context->interrupt_master_enable = false;
-  LOG(INFO) << "IME disabled.";
+  DIAGNOSE(2, CPU, "IME disabled.");
   // PrintInstruction(context->frame_factory, "DI");
   return instruction_ptr;
 }
@@ -787,7 +795,7 @@ int DI(const decompiler::Instruction&, ExecutorContext* context) {
 int EI(const decompiler::Instruction&, ExecutorContext* context) {
   int instruction_ptr = *context->instruction_ptr;
   *context->interrupt_master_enable = true;
-  LOG(INFO) << "IME enabled.";
+  DIAGNOSE(2, CPU, "IME enabled.");
   // PrintInstruction(context->frame_factory, "EI");
   return instruction_ptr;
 }
@@ -1115,24 +1123,28 @@ int JumpConditional(const decompiler::Instruction& instruction, ExecutorContext*
     case 0xC2:
       // PrintInstruction(context->frame_factory, "JP", "NZ", Hex(GetAddress16(context->memory_mapper, instruction_ptr)));
       if (!context->cpu->flag_struct.rF.Z) {
+        context->extra_cycles = kTakenJumpCycles;
         return GetParameterValue16Bit(instruction.arg2, context->cpu);
       }
       return instruction_ptr;
     case 0xCA:
       // PrintInstruction(context->frame_factory, "JP", "Z", Hex(GetAddress16(context->memory_mapper, instruction_ptr)));
       if (context->cpu->flag_struct.rF.Z) {
+        context->extra_cycles = kTakenJumpCycles;
         return GetParameterValue16Bit(instruction.arg2, context->cpu);
       }
       return instruction_ptr;
     case 0xD2:
       // PrintInstruction(context->frame_factory, "JP", "NC", Hex(GetAddress16(context->memory_mapper, instruction_ptr)));
       if (!context->cpu->flag_struct.rF.C) {
+        context->extra_cycles = kTakenJumpCycles;
         return GetParameterValue16Bit(instruction.arg2, context->cpu);
       }
       return instruction_ptr;
     case 0xDA:
       // PrintInstruction(context->frame_factory, "JP", "C", Hex(GetAddress16(context->memory_mapper, instruction_ptr)));
       if (context->cpu->flag_struct.rF.C) {
+        context->extra_cycles = kTakenJumpCycles;
         return GetParameterValue16Bit(instruction.arg2, context->cpu);
       }
       return instruction_ptr;
@@ -1161,24 +1173,28 @@ int JumpRelativeConditional(const decompiler::Instruction& instruction, Executor
     case 0x20:
       // PrintInstruction(context->frame_factory, "JR", "NZ", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
       if (!context->cpu->flag_struct.rF.Z) {
+        context->extra_cycles = kTakenJumpCycles;
         return instruction_ptr + GetParameterValue8BitSigned(instruction.arg2, context->cpu);
       }
       return instruction_ptr;
     case 0x28:
       // PrintInstruction(context->frame_factory, "JR", "Z", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
       if (context->cpu->flag_struct.rF.Z) {
+        context->extra_cycles = kTakenJumpCycles;
         return instruction_ptr + GetParameterValue8BitSigned(instruction.arg2, context->cpu);
       }
       return instruction_ptr;
     case 0x30:
       // PrintInstruction(context->frame_factory, "JR", "NC", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
       if (!context->cpu->flag_struct.rF.C) {
+        context->extra_cycles = kTakenJumpCycles;
         return instruction_ptr + GetParameterValue8BitSigned(instruction.arg2, context->cpu);
       }
       return instruction_ptr;
     case 0x38:
       // PrintInstruction(context->frame_factory, "JR", "C", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
       if (context->cpu->flag_struct.rF.C) {
+        context->extra_cycles = kTakenJumpCycles;
         return instruction_ptr + GetParameterValue8BitSigned(instruction.arg2, context->cpu);
       }
       return instruction_ptr;
@@ -1191,12 +1207,10 @@ int JumpRelativeConditional(const decompiler::Instruction& instruction, Executor
 // specific work in functions that we can either swap out at compile time or at
 // runtime to preserve correct endianness.
 uint8_t GetLSB(uint16_t value) {
-  LOG(INFO) << "Pushing, lsb is " << std::hex << 0x0000 + static_cast<uint8_t>(value);
   return static_cast<uint8_t>(value);
 }
 
 uint8_t GetMSB(uint16_t value) {
-  LOG(INFO) << "Pushing, msb is " << std::hex << 0x0000 + static_cast<uint8_t>(value >> 8);
   return static_cast<uint8_t>(value >> 8);
 }
 
@@ -1207,7 +1221,7 @@ void PushRegister(MemoryMapper* memory_mapper, GB_CPU* cpu, uint16_t* reg) {
   memory_mapper->Write(*rSP, GetLSB(*reg));
   --*rSP;
   memory_mapper->Write(*rSP, GetMSB(*reg));
-  LOG(INFO) << "SP = 0x" << std::hex << *rSP;
+  DIAGNOSE(2, CPU, "Pushed 0x%x, SP = 0x%x", *reg, *rSP);
 }
 
 uint16_t PollRegister(MemoryMapper* memory_mapper, uint16_t rSP) {
@@ -1234,7 +1248,7 @@ int Call(const decompiler::Instruction& instruction, ExecutorContext* context) {
   // context->call_stack->Push({context->frame_factory->current_timestamp(), *rPC});
   PushRegister(context->memory_mapper, cpu, &cpu->rPC);
 
-  LOG(INFO) << "Calling address: " << std::hex << address;
+  DIAGNOSE(2, CPU, "Calling address: 0x%x", address);
   instruction_ptr = address;
   
   // PrintInstruction(context->frame_factory, "CALL", Hex(address));
@@ -1249,7 +1263,7 @@ int CallConditionalImpl(const decompiler::Instruction& instruction, ExecutorCont
   // context->call_stack->Push({context->frame_factory->current_timestamp(), *rPC});
   PushRegister(context->memory_mapper, cpu, &cpu->rPC);
 
-  LOG(INFO) << "Calling address: " << std::hex << address;
+  DIAGNOSE(2, CPU, "Calling address: 0x%x", address);
   instruction_ptr = address;
   
   // PrintInstruction(context->frame_factory, "CALL", Hex(address));
@@ -1262,24 +1276,28 @@ int CallConditional(const decompiler::Instruction& instruction, ExecutorContext*
     case 0xC4:
       // PrintInstruction(context->frame_factory, "CALL", "NZ", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
       if (!context->cpu->flag_struct.rF.Z) {
+        context->extra_cycles = kTakenCallCycles;
         return CallConditionalImpl(instruction, context);
       }
       return instruction_ptr;
     case 0xCC:
       // PrintInstruction(context->frame_factory, "CALL", "Z", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
       if (context->cpu->flag_struct.rF.Z) {
+        context->extra_cycles = kTakenCallCycles;
         return CallConditionalImpl(instruction, context);
       }
       return instruction_ptr;
     case 0xD4:
       // PrintInstruction(context->frame_factory, "CALL", "NC", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
       if (!context->cpu->flag_struct.rF.C) {
+        context->extra_cycles = kTakenCallCycles;
         return CallConditionalImpl(instruction, context);
       }
       return instruction_ptr;
     case 0xDC:
       // PrintInstruction(context->frame_factory, "CALL", "C", Hex(GetParameterValue(context->memory_mapper, instruction_ptr)));
       if (context->cpu->flag_struct.rF.C) {
+        context->extra_cycles = kTakenCallCycles;
         return CallConditionalImpl(instruction, context);
       }
       return instruction_ptr;
@@ -1313,14 +1331,14 @@ int Restart(const decompiler::Instruction& instruction, ExecutorContext* context
   // context->call_stack->Push({context->frame_factory->current_timestamp(), cpu->rPC});
   PushRegister(context->memory_mapper, cpu, &cpu->rPC);
 
-  LOG(INFO) << "Restarting at address: " << std::hex << instruction_ptr;
+  DIAGNOSE(2, CPU, "Restarting at address: 0x%x", instruction_ptr);
   
   // PrintInstruction(context->frame_factory, "RST", Hex(opcode.opcode_name));
   return instruction_ptr;
 }
 
 int Return(const decompiler::Instruction&, ExecutorContext* context) {
-  LOG(INFO) << "Returning";
+  DIAGNOSE(2, CPU, "Returning");
   PopRegister(context->memory_mapper, context->cpu, &context->cpu->rPC);
   // PrintInstruction(context->frame_factory, "RET");
   // if (!context->call_stack->PeekCheck(context->cpu->rPC)) {
@@ -1335,30 +1353,34 @@ int Return(const decompiler::Instruction&, ExecutorContext* context) {
 }
 
 int ReturnConditional(const decompiler::Instruction& instruction, ExecutorContext* context) {
-  LOG(INFO) << "Conditional return";
+  DIAGNOSE(2, CPU, "Conditional return");
   int instruction_ptr = *context->instruction_ptr;
   switch (instruction.instruction) {
     case 0xC0:
       // PrintInstruction(context->frame_factory, "RET", "NZ");
       if (!context->cpu->flag_struct.rF.Z) {
+        context->extra_cycles = kTakenReturnCycles;
         return Return(instruction, context);
       }
       return instruction_ptr;
     case 0xC8:
       // PrintInstruction(context->frame_factory, "RET", "Z");
       if (context->cpu->flag_struct.rF.Z) {
+        context->extra_cycles = kTakenReturnCycles;
         return Return(instruction, context);
       }
       return instruction_ptr;
     case 0xD0:
       // PrintInstruction(context->frame_factory, "RET", "NC");
       if (!context->cpu->flag_struct.rF.C) {
+        context->extra_cycles = kTakenReturnCycles;
         return Return(instruction, context);
       }
       return instruction_ptr;
     case 0xD8:
       // PrintInstruction(context->frame_factory, "RET", "C");
       if (context->cpu->flag_struct.rF.C) {
+        context->extra_cycles = kTakenReturnCycles;
         return Return(instruction, context);
       }
   }
@@ -1366,7 +1388,7 @@ int ReturnConditional(const decompiler::Instruction& instruction, ExecutorContex
 }
 
 int ReturnInterrupt(const decompiler::Instruction& instruction, ExecutorContext* context) {
-  LOG(INFO) << "Returning from interrupt.";
+  DIAGNOSE(2, CPU, "Returning from interrupt.");
   ExecutorContext new_context(context);
   EI(instruction, context);
   
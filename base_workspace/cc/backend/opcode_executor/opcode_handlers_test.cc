@@ -4,11 +4,13 @@
 #include "cc/backend/graphics/screen.h"
 #include "cc/backend/memory/dma_transfer/dma_transfer.h"
 #include "cc/backend/memory/mbc/mbc_module.h"
+#include "cc/backend/memory/mbc/rom_image.h"
 #include "cc/backend/memory/ram/default_module.h"
 #include "cc/backend/memory/unimplemented/unimplemented_module.h"
 #include "cc/backend/opcode_executor/opcode_executor.h"
 #include "cc/backend/opcode_executor/opcode_handlers.h"
 #include "cc/backend/opcode_executor/opcodes.h"
+#include "cc/backend/scheduler/scheduler.h"
 #include "cc/test_harness/test_harness.h"
 #include "cc/test_harness/test_harness_utils.h"
 #include "gtest/gtest.h"
@@ -29,8 +31,10 @@ using memory::DefaultModule;
 using memory::MBCModule;
 using memory::MemoryMapper;
 using memory::PrimaryFlags;
+using memory::ROMImage;
 using memory::UnimplementedModule;
 using opcode_executor::OpcodeExecutor;
+using std::shared_ptr;
 using std::unique_ptr;
 using std::vector;
 
@@ -67,25 +71,24 @@ OpcodeExecutor* BuildOpcodeExecutor() {
   default_module->Init();
   memory_mapper->RegisterModule(*default_module);
 
+  scheduler::Scheduler* scheduler = new scheduler::Scheduler();
+
   DMATransferModule* dma_transfer_module = new DMATransferModule();
-  dma_transfer_module->Init(memory_mapper.get());
+  dma_transfer_module->Init(memory_mapper.get(), scheduler);
   memory_mapper->RegisterModule(*dma_transfer_module);
 
   MBCModule* mbc = new MBCModule();
-  vector<uint8_t> rom(0x150);
-  rom[0x147] = 0x00;
-  mbc->Init(rom.data(), 0x150);
+  shared_ptr<ROMImage> rom = ROMImage::Allocate(0x150);
+  rom->data()[0x147] = 0x00;
+  mbc->Init(rom);
   memory_mapper->RegisterModule(*mbc);
 
   GraphicsController* graphics_controller = new GraphicsController(new NullScreen(), primary_flags);
-  graphics_controller->Init();
+  graphics_controller->Init(scheduler);
   memory_mapper->RegisterModule(*graphics_controller);
 
   OpcodeExecutor* opcode_executor = new OpcodeExecutor(std::move(memory_mapper), 
-                                                       primary_flags, 
-                                                       mbc->internal_rom_flag()
-                                                       );
-  opcode_executor->Init();
+                                                       primary_flags);
   cached_executor = opcode_executor;
   // TODO(Brendan): We should zero out the executor on the first run.
   return opcode_executor;
@@ -9,6 +9,528 @@ namespace opcode_executor {
 
 using std::vector;
 
+// Indexed by the opcode byte. STOP (0x10 0x00) is handled separately since its
+// normalized encoding is 0x1000.
+constexpr OpcodeHandlerFunction kOpcodeTable[kOpcodeTableSize] = {
+    NOP,                      // 0x00
+    LoadNN,                   // 0x01
+    LoadNAAddress,            // 0x02
+    Inc16Bit,                 // 0x03
+    Inc8Bit,                  // 0x04
+    Dec8Bit,                  // 0x05
+    LoadN,                    // 0x06
+    RLCA,                     // 0x07
+    LoadNNSP,                 // 0x08
+    Add16Bit,                 // 0x09
+    LoadAN,                   // 0x0A
+    Dec16Bit,                 // 0x0B
+    Inc8Bit,                  // 0x0C
+    Dec8Bit,                  // 0x0D
+    LoadN,                    // 0x0E
+    RRCA,                     // 0x0F
+    nullptr,                  // 0x10
+    LoadNN,                   // 0x11
+    LoadNAAddress,            // 0x12
+    Inc16Bit,                 // 0x13
+    Inc8Bit,                  // 0x14
+    Dec8Bit,                  // 0x15
+    LoadN,                    // 0x16
+    RLA,                      // 0x17
+    JumpRelative,             // 0x18
+    Add16Bit,                 // 0x19
+    LoadAN,                   // 0x1A
+    Dec16Bit,                 // 0x1B
+    Inc8Bit,                  // 0x1C
+    Dec8Bit,                  // 0x1D
+    LoadN,                    // 0x1E
+    RRA,                      // 0x1F
+    JumpRelativeConditional,  // 0x20
+    LoadNN,                   // 0x21
+    LoadIncHLA,               // 0x22
+    Inc16Bit,                 // 0x23
+    Inc8Bit,                  // 0x24
+    Dec8Bit,                  // 0x25
+    LoadN,                    // 0x26
+    DAA,                      // 0x27
+    JumpRelativeConditional,  // 0x28
+    Add16Bit,                 // 0x29
+    LoadIncAHL,               // 0x2A
+    Dec16Bit,                 // 0x2B
+    Inc8Bit,                  // 0x2C
+    Dec8Bit,                  // 0x2D
+    LoadN,                    // 0x2E
+    CPL,                      // 0x2F
+    JumpRelativeConditional,  // 0x30
+    LoadNN,                   // 0x31
+    LoadDecHLA,               // 0x32
+    Inc16Bit,                 // 0x33
+    Inc8BitAddress,           // 0x34
+    Dec8BitAddress,           // 0x35
+    Load8BitLiteral,          // 0x36
+    SCF,                      // 0x37
+    JumpRelativeConditional,  // 0x38
+    Add16Bit,                 // 0x39
+    LoadDecAHL,               // 0x3A
+    Dec16Bit,                 // 0x3B
+    Inc8Bit,                  // 0x3C
+    Dec8Bit,                  // 0x3D
+    LoadAN8BitLiteral,        // 0x3E
+    CCF,                      // 0x3F
+    LoadRR8Bit,               // 0x40
+    LoadRR8Bit,               // 0x41
+    LoadRR8Bit,               // 0x42
+    LoadRR8Bit,               // 0x43
+    LoadRR8Bit,               // 0x44
+    LoadRR8Bit,               // 0x45
+    LoadRR8BitAddress,        // 0x46
+    LoadNA,                   // 0x47
+    LoadRR8Bit,               // 0x48
+    LoadRR8Bit,               // 0x49
+    LoadRR8Bit,               // 0x4A
+    LoadRR8Bit,               // 0x4B
+    LoadRR8Bit,               // 0x4C
+    LoadRR8Bit,               // 0x4D
+    LoadRR8BitAddress,        // 0x4E
+    LoadNA,                   // 0x4F
+    LoadRR8Bit,               // 0x50
+    LoadRR8Bit,               // 0x51
+    LoadRR8Bit,               // 0x52
+    LoadRR8Bit,               // 0x53
+    LoadRR8Bit,               // 0x54
+    LoadRR8Bit,               // 0x55
+    LoadRR8BitAddress,        // 0x56
+    LoadNA,                   // 0x57
+    LoadRR8Bit,               // 0x58
+    LoadRR8Bit,               // 0x59
+    LoadRR8Bit,               // 0x5A
+    LoadRR8Bit,               // 0x5B
+    LoadRR8Bit,               // 0x5C
+    LoadRR8Bit,               // 0x5D
+    LoadRR8BitAddress,        // 0x5E
+    LoadNA,                   // 0x5F
+    LoadRR8Bit,               // 0x60
+    LoadRR8Bit,               // 0x61
+    LoadRR8Bit,               // 0x62
+    LoadRR8Bit,               // 0x63
+    LoadRR8Bit,               // 0x64
+    LoadRR8Bit,               // 0x65
+    LoadRR8BitAddress,        // 0x66
+    LoadNA,                   // 0x67
+    LoadRR8Bit,               // 0x68
+    LoadRR8Bit,               // 0x69
+    LoadRR8Bit,               // 0x6A
+    LoadRR8Bit,               // 0x6B
+    LoadRR8Bit,               // 0x6C
+    LoadRR8Bit,               // 0x6D
+    LoadRR8BitAddress,        // 0x6E
+    LoadNA,                   // 0x6F
+    LoadRR8BitIntoAddress,    // 0x70
+    LoadRR8BitIntoAddress,    // 0x71
+    LoadRR8BitIntoAddress,    // 0x72
+    LoadRR8BitIntoAddress,    // 0x73
+    LoadRR8BitIntoAddress,    // 0x74
+    LoadRR8BitIntoAddress,    // 0x75
+    Halt,                     // 0x76
+    LoadNAAddress,            // 0x77
+    LoadRR8Bit,               // 0x78
+    LoadRR8Bit,               // 0x79
+    LoadRR8Bit,               // 0x7A
+    LoadRR8Bit,               // 0x7B
+    LoadRR8Bit,               // 0x7C
+    LoadRR8Bit,               // 0x7D
+    LoadRR8BitAddress,        // 0x7E
+    LoadRR8Bit,               // 0x7F
+    Add8Bit,                  // 0x80
+    Add8Bit,                  // 0x81
+    Add8Bit,                  // 0x82
+    Add8Bit,                  // 0x83
+    Add8Bit,                  // 0x84
+    Add8Bit,                  // 0x85
+    Add8BitAddress,           // 0x86
+    Add8Bit,                  // 0x87
+    ADC8Bit,                  // 0x88
+    ADC8Bit,                  // 0x89
+    ADC8Bit,                  // 0x8A
+    ADC8Bit,                  // 0x8B
+    ADC8Bit,                  // 0x8C
+    ADC8Bit,                  // 0x8D
+    ADC8BitAddress,           // 0x8E
+    ADC8Bit,                  // 0x8F
+    Sub8Bit,                  // 0x90
+    Sub8Bit,                  // 0x91
+    Sub8Bit,                  // 0x92
+    Sub8Bit,                  // 0x93
+    Sub8Bit,                  // 0x94
+    Sub8Bit,                  // 0x95
+    Sub8BitAddress,           // 0x96
+    Sub8Bit,                  // 0x97
+    SBC8Bit,                  // 0x98
+    SBC8Bit,                  // 0x99
+    SBC8Bit,                  // 0x9A
+    SBC8Bit,                  // 0x9B
+    SBC8Bit,                  // 0x9C
+    SBC8Bit,                  // 0x9D
+    SBC8BitAddress,           // 0x9E
+    SBC8Bit,                  // 0x9F
+    And8Bit,                  // 0xA0
+    And8Bit,                  // 0xA1
+    And8Bit,                  // 0xA2
+    And8Bit,                  // 0xA3
+    And8Bit,                  // 0xA4
+    And8Bit,                  // 0xA5
+    And8BitAddress,           // 0xA6
+    And8Bit,                  // 0xA7
+    Xor8Bit,                  // 0xA8
+    Xor8Bit,                  // 0xA9
+    Xor8Bit,                  // 0xAA
+    Xor8Bit,                  // 0xAB
+    Xor8Bit,                  // 0xAC
+    Xor8Bit,                  // 0xAD
+    Xor8BitAddress,           // 0xAE
+    Xor8Bit,                  // 0xAF
+    Or8Bit,                   // 0xB0
+    Or8Bit,                   // 0xB1
+    Or8Bit,                   // 0xB2
+    Or8Bit,                   // 0xB3
+    Or8Bit,                   // 0xB4
+    Or8Bit,                   // 0xB5
+    Or8BitAddress,            // 0xB6
+    Or8Bit,                   // 0xB7
+    Cp8Bit,                   // 0xB8
+    Cp8Bit,                   // 0xB9
+    Cp8Bit,                   // 0xBA
+    Cp8Bit,                   // 0xBB
+    Cp8Bit,                   // 0xBC
+    Cp8Bit,                   // 0xBD
+    Cp8BitAddress,            // 0xBE
+    Cp8Bit,                   // 0xBF
+    ReturnConditional,        // 0xC0
+    Pop,                      // 0xC1
+    JumpConditional,          // 0xC2
+    Jump,                     // 0xC3
+    CallConditional,          // 0xC4
+    Push,                     // 0xC5
+    Add8BitLiteral,           // 0xC6
+    Restart,                  // 0xC7
+    ReturnConditional,        // 0xC8
+    Return,                   // 0xC9
+    JumpConditional,          // 0xCA
+    nullptr,                  // 0xCB
+    CallConditional,          // 0xCC
+    Call,                     // 0xCD
+    ADC8BitLiteral,           // 0xCE
+    Restart,                  // 0xCF
+    ReturnConditional,        // 0xD0
+    Pop,                      // 0xD1
+    JumpConditional,          // 0xD2
+    nullptr,                  // 0xD3
+    CallConditional,          // 0xD4
+    Push,                     // 0xD5
+    Sub8BitLiteral,           // 0xD6
+    Restart,                  // 0xD7
+    ReturnConditional,        // 0xD8
+    ReturnInterrupt,          // 0xD9
+    JumpConditional,          // 0xDA
+    nullptr,                  // 0xDB
+    CallConditional,          // 0xDC
+    nullptr,                  // 0xDD
+    SBC8BitLiteral,           // 0xDE
+    Restart,                  // 0xDF
+    LoadHNA,                  // 0xE0
+    Pop,                      // 0xE1
+    LoadCA,                   // 0xE2
+    nullptr,                  // 0xE3
+    nullptr,                  // 0xE4
+    Push,                     // 0xE5
+    And8BitLiteral,           // 0xE6
+    Restart,                  // 0xE7
+    AddSPLiteral,             // 0xE8
+    JumpHL,                   // 0xE9
+    LoadNA16BitLiteral,       // 0xEA
+    nullptr,                  // 0xEB
+    nullptr,                  // 0xEC
+    nullptr,                  // 0xED
+    Xor8BitLiteral,           // 0xEE
+    Restart,                  // 0xEF
+    LoadHAN,                  // 0xF0
+    Pop,                      // 0xF1
+    LoadAC,                   // 0xF2
+    DI,                       // 0xF3
+    nullptr,                  // 0xF4
+    Push,                     // 0xF5
+    Or8BitLiteral,            // 0xF6
+    Restart,                  // 0xF7
+    LoadHLSP,                 // 0xF8
+    LoadSPHL,                 // 0xF9
+    LoadAN16BitLiteral,       // 0xFA
+    EI,                       // 0xFB
+    nullptr,                  // 0xFC
+    nullptr,                  // 0xFD
+    Cp8BitLiteral,            // 0xFE
+    Restart,                  // 0xFF
+};
+
+// Indexed by the byte following the 0xCB prefix. The bit operations are listed
+// for every bit index even though the decompiler masks the index out.
+constexpr OpcodeHandlerFunction kCBOpcodeTable[kOpcodeTableSize] = {
+    RLC,                      // 0x00
+    RLC,                      // 0x01
+    RLC,                      // 0x02
+    RLC,                      // 0x03
+    RLC,                      // 0x04
+    RLC,                      // 0x05
+    RLCAddress,               // 0x06
+    RLC,                      // 0x07
+    RRC,                      // 0x08
+    RRC,                      // 0x09
+    RRC,                      // 0x0A
+    RRC,                      // 0x0B
+    RRC,                      // 0x0C
+    RRC,                      // 0x0D
+    RRCAddress,               // 0x0E
+    RRC,                      // 0x0F
+    RL,                       // 0x10
+    RL,                       // 0x11
+    RL,                       // 0x12
+    RL,                       // 0x13
+    RL,                       // 0x14
+    RL,                       // 0x15
+    RLAddress,                // 0x16
+    RL,                       // 0x17
+    RR,                       // 0x18
+    RR,                       // 0x19
+    RR,                       // 0x1A
+    RR,                       // 0x1B
+    RR,                       // 0x1C
+    RR,                       // 0x1D
+    RRAddress,                // 0x1E
+    RR,                       // 0x1F
+    SLA,                      // 0x20
+    SLA,                      // 0x21
+    SLA,                      // 0x22
+    SLA,                      // 0x23
+    SLA,                      // 0x24
+    SLA,                      // 0x25
+    SLAAddress,               // 0x26
+    SLA,                      // 0x27
+    SRA,                      // 0x28
+    SRA,                      // 0x29
+    SRA,                      // 0x2A
+    SRA,                      // 0x2B
+    SRA,                      // 0x2C
+    SRA,                      // 0x2D
+    SRAAddress,               // 0x2E
+    SRA,                      // 0x2F
+    Swap,                     // 0x30
+    Swap,                     // 0x31
+    Swap,                     // 0x32
+    Swap,                     // 0x33
+    Swap,                     // 0x34
+    Swap,                     // 0x35
+    SwapAddress,              // 0x36
+    Swap,                     // 0x37
+    SRL,                      // 0x38
+    SRL,                      // 0x39
+    SRL,                      // 0x3A
+    SRL,                      // 0x3B
+    SRL,                      // 0x3C
+    SRL,                      // 0x3D
+    SRLAddress,               // 0x3E
+    SRL,                      // 0x3F
+    Bit,                      // 0x40
+    Bit,                      // 0x41
+    Bit,                      // 0x42
+    Bit,                      // 0x43
+    Bit,                      // 0x44
+    Bit,                      // 0x45
+    BitAddress,               // 0x46
+    Bit,                      // 0x47
+    Bit,                      // 0x48
+    Bit,                      // 0x49
+    Bit,                      // 0x4A
+    Bit,                      // 0x4B
+    Bit,                      // 0x4C
+    Bit,                      // 0x4D
+    BitAddress,               // 0x4E
+    Bit,                      // 0x4F
+    Bit,                      // 0x50
+    Bit,                      // 0x51
+    Bit,                      // 0x52
+    Bit,                      // 0x53
+    Bit,                      // 0x54
+    Bit,                      // 0x55
+    BitAddress,               // 0x56
+    Bit,                      // 0x57
+    Bit,                      // 0x58
+    Bit,                      // 0x59
+    Bit,                      // 0x5A
+    Bit,                      // 0x5B
+    Bit,                      // 0x5C
+    Bit,                      // 0x5D
+    BitAddress,               // 0x5E
+    Bit,                      // 0x5F
+    Bit,                      // 0x60
+    Bit,                      // 0x61
+    Bit,                      // 0x62
+    Bit,                      // 0x63
+    Bit,                      // 0x64
+    Bit,                      // 0x65
+    BitAddress,               // 0x66
+    Bit,                      // 0x67
+    Bit,                      // 0x68
+    Bit,                      // 0x69
+    Bit,                      // 0x6A
+    Bit,                      // 0x6B
+    Bit,                      // 0x6C
+    Bit,                      // 0x6D
+    BitAddress,               // 0x6E
+    Bit,                      // 0x6F
+    Bit,                      // 0x70
+    Bit,                      // 0x71
+    Bit,                      // 0x72
+    Bit,                      // 0x73
+    Bit,                      // 0x74
+    Bit,                      // 0x75
+    BitAddress,               // 0x76
+    Bit,                      // 0x77
+    Bit,                      // 0x78
+    Bit,                      // 0x79
+    Bit,                      // 0x7A
+    Bit,                      // 0x7B
+    Bit,                      // 0x7C
+    Bit,                      // 0x7D
+    BitAddress,               // 0x7E
+    Bit,                      // 0x7F
+    Res,                      // 0x80
+    Res,                      // 0x81
+    Res,                      // 0x82
+    Res,                      // 0x83
+    Res,                      // 0x84
+    Res,                      // 0x85
+    Res,                      // 0x86
+    Res,                      // 0x87
+    Res,                      // 0x88
+    Res,                      // 0x89
+    Res,                      // 0x8A
+    Res,                      // 0x8B
+    Res,                      // 0x8C
+    Res,                      // 0x8D
+    Res,                      // 0x8E
+    Res,                      // 0x8F
+    Res,                      // 0x90
+    Res,                      // 0x91
+    Res,                      // 0x92
+    Res,                      // 0x93
+    Res,                      // 0x94
+    Res,                      // 0x95
+    Res,                      // 0x96
+    Res,                      // 0x97
+    Res,                      // 0x98
+    Res,                      // 0x99
+    Res,                      // 0x9A
+    Res,                      // 0x9B
+    Res,                      // 0x9C
+    Res,                      // 0x9D
+    Res,                      // 0x9E
+    Res,                      // 0x9F
+    Res,                      // 0xA0
+    Res,                      // 0xA1
+    Res,                      // 0xA2
+    Res,                      // 0xA3
+    Res,                      // 0xA4
+    Res,                      // 0xA5
+    Res,                      // 0xA6
+    Res,                      // 0xA7
+    Res,                      // 0xA8
+    Res,                      // 0xA9
+    Res,                      // 0xAA
+    Res,                      // 0xAB
+    Res,                      // 0xAC
+    Res,                      // 0xAD
+    Res,                      // 0xAE
+    Res,                      // 0xAF
+    Res,                      // 0xB0
+    Res,                      // 0xB1
+    Res,                      // 0xB2
+    Res,                      // 0xB3
+    Res,                      // 0xB4
+    Res,                      // 0xB5
+    Res,                      // 0xB6
+    Res,                      // 0xB7
+    Res,                      // 0xB8
+    Res,                      // 0xB9
+    Res,                      // 0xBA
+    Res,                      // 0xBB
+    Res,                      // 0xBC
+    Res,                      // 0xBD
+    Res,                      // 0xBE
+    Res,                      // 0xBF
+    Set,                      // 0xC0
+    Set,                      // 0xC1
+    Set,                      // 0xC2
+    Set,                      // 0xC3
+    Set,                      // 0xC4
+    Set,                      // 0xC5
+    Set,                      // 0xC6
+    Set,                      // 0xC7
+    Set,                      // 0xC8
+    Set,                      // 0xC9
+    Set,                      // 0xCA
+    Set,                      // 0xCB
+    Set,                      // 0xCC
+    Set,                      // 0xCD
+    Set,                      // 0xCE
+    Set,                      // 0xCF
+    Set,                      // 0xD0
+    Set,                      // 0xD1
+    Set,                      // 0xD2
+    Set,                      // 0xD3
+    Set,                      // 0xD4
+    Set,                      // 0xD5
+    Set,                      // 0xD6
+    Set,                      // 0xD7
+    Set,                      // 0xD8
+    Set,                      // 0xD9
+    Set,                      // 0xDA
+    Set,                      // 0xDB
+    Set,                      // 0xDC
+    Set,                      // 0xDD
+    Set,                      // 0xDE
+    Set,                      // 0xDF
+    Set,                      // 0xE0
+    Set,                      // 0xE1
+    Set,                      // 0xE2
+    Set,                      // 0xE3
+    Set,                      // 0xE4
+    Set,                      // 0xE5
+    Set,                      // 0xE6
+    Set,                      // 0xE7
+    Set,                      // 0xE8
+    Set,                      // 0xE9
+    Set,                      // 0xEA
+    Set,                      // 0xEB
+    Set,                      // 0xEC
+    Set,                      // 0xED
+    Set,                      // 0xEE
+    Set,                      // 0xEF
+    Set,                      // 0xF0
+    Set,                      // 0xF1
+    Set,                      // 0xF2
+    Set,                      // 0xF3
+    Set,                      // 0xF4
+    Set,                      // 0xF5
+    Set,                      // 0xF6
+    Set,                      // 0xF7
+    Set,                      // 0xF8
+    Set,                      // 0xF9
+    Set,                      // 0xFA
+    Set,                      // 0xFB
+    Set,                      // 0xFC
+    Set,                      // 0xFD
+    Set,                      // 0xFE
+    Set,                      // 0xFF
+};
+
 std::map<uint16_t, OpcodeHandler> CreateOpcodeMap() {
   return {
         {0x06, LoadN},
@@ -2,6 +2,7 @@
 #define TURBO_SANTA_COMMON_BACK_END_OPCODE_EXECUTOR_OPCODE_MAP_H_
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <map>
 
@@ -13,7 +14,30 @@ namespace backend {
 namespace opcode_executor {
 
 typedef std::function<int(const decompiler::Instruction&, ExecutorContext*)> OpcodeHandler;
+typedef int (*OpcodeHandlerFunction)(const decompiler::Instruction&, ExecutorContext*);
 
+const int kOpcodeTableSize = 256;
+const uint16_t kStopInstruction = 0x1000;
+
+// Dispatch tables for the base opcodes and the 0xCB prefixed opcodes; unused
+// opcodes are nullptr.
+extern const OpcodeHandlerFunction kOpcodeTable[kOpcodeTableSize];
+extern const OpcodeHandlerFunction kCBOpcodeTable[kOpcodeTableSize];
+
+// Returns the handler for a normalized instruction value (as produced by the
+// decompiler) or nullptr if there is none.
+inline OpcodeHandlerFunction LookUpOpcodeHandler(uint16_t instruction) {
+  if (instruction < kOpcodeTableSize) {
+    return kOpcodeTable[instruction];
+  } else if ((instruction >> 8) == 0xCB) {
+    return kCBOpcodeTable[instruction & 0xff];
+  } else if (instruction == kStopInstruction) {
+    return Stop;
+  }
+  return nullptr;
+}
+
+// Kept for tests; the executor dispatches through LookUpOpcodeHandler.
 std::map<uint16_t, OpcodeHandler> CreateOpcodeMap();
 
 } // namespace opcodes
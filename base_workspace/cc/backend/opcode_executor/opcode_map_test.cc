@@ -0,0 +1,37 @@
+#include <map>
+
+#include "cc/backend/opcode_executor/opcode_handlers.h"
+#include "cc/backend/opcode_executor/opcode_map.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace opcode_executor {
+
+// The dispatch tables must agree with the opcode map for every opcode the map
+// knows about.
+TEST(OpcodeMapTest, TablesMatchOpcodeMap) {
+  std::map<uint16_t, OpcodeHandler> opcode_map = CreateOpcodeMap();
+  for (const auto& entry : opcode_map) {
+    OpcodeHandlerFunction handler = LookUpOpcodeHandler(entry.first);
+    ASSERT_NE(nullptr, handler) << "Missing handler for 0x" << std::hex << entry.first;
+    EXPECT_EQ(handler, *entry.second.target<OpcodeHandlerFunction>())
+        << "Wrong handler for 0x" << std::hex << entry.first;
+  }
+}
+
+TEST(OpcodeMapTest, UnusedOpcodesHaveNoHandler) {
+  std::map<uint16_t, OpcodeHandler> opcode_map = CreateOpcodeMap();
+  for (uint16_t opcode = 0; opcode < kOpcodeTableSize; opcode++) {
+    if (opcode_map.find(opcode) == opcode_map.end()) {
+      EXPECT_EQ(nullptr, LookUpOpcodeHandler(opcode)) << "0x" << std::hex << opcode;
+    }
+  }
+}
+
+TEST(OpcodeMapTest, Stop) {
+  EXPECT_EQ(nullptr, LookUpOpcodeHandler(0x10));
+  EXPECT_EQ(Stop, LookUpOpcodeHandler(kStopInstruction));
+}
+
+} // namespace opcode_executor
+} // namespace backend
@@ -3,13 +3,10 @@
 
 #include <cstdint>
 #include <memory>
-#include "cc/backend/memory/memory_mapper_rom_bridge.h"
 
 namespace backend {
 namespace decompiler {
-class Decompiler;
 class Instruction;
-class ROMReader;
 } // namespace decompiler
 } // namespace backend
 
@@ -22,36 +19,18 @@ class MemoryMapper;
 namespace backend {
 namespace opcode_executor {
 
+class InstructionCache;
+
 class OpcodeParser {
  public:
-  OpcodeParser(const memory::MemoryMapper& memory_mapper);
-  void Init();
-  void Reset();
-  bool FetchInstruction(uint16_t address,
-                        uint16_t return_value,
-                        uint16_t hl_value,
-                        decompiler::Instruction* instruction);
+  OpcodeParser(memory::MemoryMapper* memory_mapper);
+  ~OpcodeParser();
 
-  bool is_dma_running() { return is_dma_running_; }
+  // Returns nullptr if there is no valid instruction at this address.
+  const decompiler::Instruction* FetchInstruction(uint16_t address);
 
  private:
-  void InitDMADecompiler(uint16_t high_ram_address);
-
-  bool FetchInstructionROM(uint16_t address,
-                           uint16_t return_value,
-                           uint16_t hl_value,
-                           decompiler::Instruction* instruction);
-
-  bool FetchInstructionDMA(uint16_t address,
-                           uint16_t return_value,
-                           uint16_t hl_value,
-                           decompiler::Instruction* instruction);
-
-  memory::MemoryMapperROMBridge rom_bridge_;
-  std::unique_ptr<decompiler::Decompiler> rom_decompiler_;
-  memory::MemoryMapperHighRAMBridge dma_bridge_;
-  std::unique_ptr<decompiler::Decompiler> dma_decompiler_;
-  bool is_dma_running_ = false;
+  std::unique_ptr<InstructionCache> instruction_cache_;
 };
 
 } // namespace opcode_executor
@@ -0,0 +1,45 @@
+#include "cc/backend/scheduler/scheduler.h"
+
+namespace backend {
+namespace scheduler {
+
+const uint64_t Scheduler::kNever;
+
+void Scheduler::Schedule(Event* event, uint64_t deadline) {
+  event->generation_++;
+  event->is_scheduled_ = true;
+  event->deadline_ = deadline;
+  heap_.push({deadline, sequence_++, event, event->generation_});
+  PopStaleEntries();
+}
+
+void Scheduler::Cancel(Event* event) {
+  event->generation_++;
+  event->is_scheduled_ = false;
+  PopStaleEntries();
+}
+
+Event* Scheduler::RunNextDueEvent() {
+  // The top entry is never stale; see PopStaleEntries.
+  if (heap_.empty() || heap_.top().deadline > now_) {
+    return nullptr;
+  }
+  Entry entry = heap_.top();
+  heap_.pop();
+  PopStaleEntries();
+  entry.event->is_scheduled_ = false;
+  // The callback may schedule events, including this one, again.
+  entry.event->callback_(entry.deadline);
+  return entry.event;
+}
+
+// Keeps next_deadline() accurate; stale entries below the top are discarded
+// when they reach it.
+void Scheduler::PopStaleEntries() {
+  while (!heap_.empty() && IsStale(heap_.top())) {
+    heap_.pop();
+  }
+}
+
+} // namespace scheduler
+} // namespace backend
@@ -0,0 +1,106 @@
+#ifndef TURBO_SANTA_COMMON_BACK_END_SCHEDULER_SCHEDULER_H_
+#define TURBO_SANTA_COMMON_BACK_END_SCHEDULER_SCHEDULER_H_
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace backend {
+namespace scheduler {
+
+// Something which needs to happen at a particular clock cycle, such as a PPU
+// mode change or a timer overflow. The callback is given the cycle the event
+// was scheduled for, which may be slightly earlier than the current cycle. The
+// name says which component the event belongs to, for profiling.
+class Event {
+ public:
+  Event(std::function<void(uint64_t)> callback, const char* name = "")
+      : callback_(callback), name_(name) {}
+
+  bool is_scheduled() const { return is_scheduled_; }
+  uint64_t deadline() const { return deadline_; }
+  const char* name() const { return name_; }
+
+ private:
+  std::function<void(uint64_t)> callback_;
+  const char* name_;
+  bool is_scheduled_ = false;
+  uint64_t deadline_ = 0;
+  // Incremented whenever the event is scheduled or cancelled so that stale
+  // entries left in the heap can be recognized.
+  uint32_t generation_ = 0;
+
+  friend class Scheduler;
+};
+
+// Keeps the emulated time, in clock cycles, and a min-heap of pending events.
+// Components register their next deadline and otherwise bring themselves up
+// to date from now() when their registers are accessed.
+class Scheduler {
+ public:
+  static const uint64_t kNever = UINT64_MAX;
+
+  uint64_t now() const { return now_; }
+
+  // Charges cycles spent by the CPU.
+  void Advance(int cycles) { now_ += cycles; }
+
+  // Jumps straight to cycle, if it has not already passed, without doing any
+  // of the work in between; used when the CPU is idle.
+  void SkipTo(uint64_t cycle) {
+    if (cycle > now_) {
+      now_ = cycle;
+    }
+  }
+
+  // The earliest deadline of any scheduled event, or kNever.
+  uint64_t next_deadline() const { 
+    return heap_.empty() ? kNever : heap_.top().deadline; 
+  }
+
+  // Schedules the event at deadline, replacing any pending deadline it had.
+  void Schedule(Event* event, uint64_t deadline);
+
+  void Cancel(Event* event);
+
+  // Runs, in order, every event whose deadline is at or before now().
+  void RunDueEvents() {
+    while (RunNextDueEvent() != nullptr) {}
+  }
+
+  // Runs the earliest event whose deadline is at or before now() and returns
+  // it, or returns nullptr if none is due.
+  Event* RunNextDueEvent();
+
+ private:
+  struct Entry {
+    uint64_t deadline;
+    uint64_t sequence;
+    Event* event;
+    uint32_t generation;
+
+    // Inverted so that std::priority_queue yields the earliest entry first;
+    // ties are broken in the order the events were scheduled.
+    bool operator<(const Entry& other) const {
+      if (deadline != other.deadline) {
+        return deadline > other.deadline;
+      }
+      return sequence > other.sequence;
+    }
+  };
+
+  bool IsStale(const Entry& entry) const {
+    return !entry.event->is_scheduled_ || entry.event->generation_ != entry.generation;
+  }
+  void PopStaleEntries();
+
+  uint64_t now_ = 0;
+  uint64_t sequence_ = 0;
+  std::priority_queue<Entry> heap_;
+};
+
+} // namespace scheduler
+} // namespace backend
+
+#endif // TURBO_SANTA_COMMON_BACK_END_SCHEDULER_SCHEDULER_H_
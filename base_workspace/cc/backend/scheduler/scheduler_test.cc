@@ -0,0 +1,104 @@
+#include <vector>
+
+#include "cc/backend/scheduler/scheduler.h"
+#include "gtest/gtest.h"
+
+namespace backend {
+namespace scheduler {
+
+using std::vector;
+
+TEST(SchedulerTest, RunsEventsInDeadlineOrder) {
+  Scheduler scheduler;
+  vector<uint64_t> fired;
+  Event first([&fired](uint64_t deadline) { fired.push_back(deadline); });
+  Event second([&fired](uint64_t deadline) { fired.push_back(deadline); });
+  scheduler.Schedule(&second, 20);
+  scheduler.Schedule(&first, 10);
+  EXPECT_EQ(10u, scheduler.next_deadline());
+
+  scheduler.Advance(15);
+  scheduler.RunDueEvents();
+  EXPECT_EQ(vector<uint64_t>({10}), fired);
+  EXPECT_FALSE(first.is_scheduled());
+  EXPECT_EQ(20u, scheduler.next_deadline());
+
+  scheduler.Advance(5);
+  scheduler.RunDueEvents();
+  EXPECT_EQ(vector<uint64_t>({10, 20}), fired);
+  EXPECT_EQ(Scheduler::kNever, scheduler.next_deadline());
+}
+
+TEST(SchedulerTest, RescheduleReplacesDeadline) {
+  Scheduler scheduler;
+  int count = 0;
+  Event event([&count](uint64_t) { count++; });
+  scheduler.Schedule(&event, 10);
+  scheduler.Schedule(&event, 30);
+  EXPECT_EQ(30u, scheduler.next_deadline());
+
+  scheduler.Advance(30);
+  scheduler.RunDueEvents();
+  EXPECT_EQ(1, count);
+}
+
+TEST(SchedulerTest, Cancel) {
+  Scheduler scheduler;
+  int count = 0;
+  Event event([&count](uint64_t) { count++; });
+  scheduler.Schedule(&event, 10);
+  scheduler.Cancel(&event);
+  EXPECT_EQ(Scheduler::kNever, scheduler.next_deadline());
+
+  scheduler.Advance(10);
+  scheduler.RunDueEvents();
+  EXPECT_EQ(0, count);
+}
+
+TEST(SchedulerTest, PeriodicEvent) {
+  Scheduler scheduler;
+  int count = 0;
+  Event* event_ptr;
+  Event event([&](uint64_t deadline) {
+    count++;
+    scheduler.Schedule(event_ptr, deadline + 4);
+  });
+  event_ptr = &event;
+  scheduler.Schedule(&event, 4);
+
+  scheduler.Advance(17);
+  scheduler.RunDueEvents();
+  EXPECT_EQ(4, count);
+  EXPECT_EQ(20u, scheduler.next_deadline());
+}
+
+TEST(SchedulerTest, RunNextDueEventReturnsEachEventInTurn) {
+  Scheduler scheduler;
+  Event first([](uint64_t) {}, "first");
+  Event second([](uint64_t) {}, "second");
+  Event cancelled([](uint64_t) {});
+  scheduler.Schedule(&second, 20);
+  scheduler.Schedule(&cancelled, 5);
+  scheduler.Schedule(&first, 10);
+  scheduler.Cancel(&cancelled);
+
+  scheduler.Advance(20);
+  EXPECT_EQ(&first, scheduler.RunNextDueEvent());
+  EXPECT_EQ(&second, scheduler.RunNextDueEvent());
+  EXPECT_STREQ("second", second.name());
+  EXPECT_EQ(nullptr, scheduler.RunNextDueEvent());
+}
+
+TEST(SchedulerTest, SkipTo) {
+  Scheduler scheduler;
+  scheduler.Advance(10);
+  scheduler.SkipTo(100);
+  EXPECT_EQ(100u, scheduler.now());
+
+  // Skipping backwards does nothing.
+  scheduler.SkipTo(50);
+  EXPECT_EQ(100u, scheduler.now());
+}
+
+} // namespace scheduler
+} // namespace backend
@@ -80,7 +80,6 @@ AssertionResult TestHarness::AssertMemoryState(const vector<MemoryAddressValuePa
 unsigned int TestHarness::ExecuteInstruction(unsigned char instruction) {
   parser_->cpu_.rPC = 0;
   parser_->memory_mapper_->ForceWrite(instruction_ptr(), instruction); // We put the instruction in right before it gets called.
-  parser_->Init();
   return parser_->ReadInstruction();
 }
 
@@ -90,7 +89,6 @@ unsigned int TestHarness::ExecuteInstruction(unsigned short instruction) {
   unsigned char msb = (unsigned char)((0xFF00 & instruction) >> 8);
   parser_->memory_mapper_->ForceWrite(instruction_ptr(), msb);
   parser_->memory_mapper_->ForceWrite(instruction_ptr() + 1, lsb);
-  parser_->Init();
   return parser_->ReadInstruction();
 }
 
@@ -100,7 +98,6 @@ unsigned int TestHarness::ExecuteInstruction(unsigned char instruction, unsigned
   // TODO(Deigo): Make sure that we are actually MSB.
   parser_->memory_mapper_->ForceWrite(instruction_ptr() + 1, static_cast<unsigned char>(value >> 8));
   parser_->memory_mapper_->ForceWrite(instruction_ptr() + 2, static_cast<unsigned char>(value));
-  parser_->Init();
   return parser_->ReadInstruction();
 }
 
@@ -108,7 +105,6 @@ unsigned int TestHarness::ExecuteInstruction(unsigned char instruction, unsigned
   parser_->cpu_.rPC = 0;
   parser_->memory_mapper_->ForceWrite(instruction_ptr(), instruction); // We put the instruction in right before it gets called.
   parser_->memory_mapper_->ForceWrite(instruction_ptr() + 1, value);
-  parser_->Init();
   return parser_->ReadInstruction();
 }
 
@@ -120,8 +116,6 @@ void TestHarness::LoadROM(const vector<TestROM>& test_rom) {
       address++;
     }
   }
-  // We have to reset the instruction parser.
-  parser_->Init();
 }
 
 void TestHarness::Run(int instruction_number_to_run) {
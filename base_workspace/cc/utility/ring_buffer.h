@@ -0,0 +1,229 @@
+#ifndef TURBO_SANTA_COMMON_UTILITY_RING_BUFFER_H_
+#define TURBO_SANTA_COMMON_UTILITY_RING_BUFFER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "cc/utility/option.h"
+
+namespace utility {
+
+// A bounded queue for passing data from exactly one producer thread to exactly
+// one consumer thread. Put and Take do not lock unless the consumer has to
+// sleep on an empty buffer or the producer on a full one, and the consumer is
+// only woken once a batch of elements is waiting (or after a short timeout),
+// rather than on every Put.
+//
+// The slots follow Vyukov's bounded queue: each carries a sequence number
+// saying whether it is ready to be written or read. That lets the producer
+// also remove the oldest element when the buffer is full and the policy is
+// DROP_OLDEST.
+template <typename T>
+class RingBuffer {
+ public:
+  enum OverflowPolicy {
+    BLOCK,       // Put waits for the consumer to make room.
+    DROP_OLDEST, // The oldest element is discarded to make room.
+    DROP_NEWEST, // The element being Put is discarded.
+  };
+
+  static const size_t kDefaultWakeBatch = 64;
+
+  // capacity is rounded up to a power of two.
+  RingBuffer(size_t capacity, OverflowPolicy policy, size_t wake_batch = kDefaultWakeBatch) :
+      capacity_(RoundUpToPowerOfTwo(capacity)),
+      mask_(capacity_ - 1),
+      policy_(policy),
+      wake_batch_(wake_batch < capacity_ ? wake_batch : capacity_),
+      slots_(capacity_) {
+    for (size_t i = 0; i < capacity_; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Must only be called from the producer thread. Does nothing once closed.
+  void Put(T value) {
+    if (is_closed()) {
+      return;
+    }
+    while (!TryPush(&value)) {
+      if (is_closed()) {
+        return;
+      }
+      switch (policy_) {
+        case DROP_NEWEST:
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return;
+        case DROP_OLDEST:
+          // If the consumer is still reading the oldest element its slot is
+          // about to be free; dropping another one would lose data for nothing.
+          if (size() >= capacity_) {
+            T oldest;
+            if (TryPop(&oldest)) {
+              dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+          } else {
+            std::this_thread::yield();
+          }
+          break;
+        case BLOCK:
+          WaitForSpace();
+          break;
+      }
+    }
+    // Only the first Put to see a sleeping consumer with a full batch waiting
+    // pays for the wakeup.
+    if (consumer_waiting_.load() && size() >= wake_batch_ && consumer_waiting_.exchange(false)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      not_empty_.notify_one();
+    }
+  }
+
+  // Must only be called from the consumer thread. Blocks until an element is
+  // available; returns None once the buffer is closed and drained.
+  Option<T> Take() {
+    T value;
+    for (;;) {
+      if (TryPop(&value)) {
+        if (producer_waiting_.load() && producer_waiting_.exchange(false)) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          not_full_.notify_one();
+        }
+        return Some<T>(value);
+      }
+      if (is_closed()) {
+        // The producer may have gotten one last element in before closing.
+        if (TryPop(&value)) {
+          return Some<T>(value);
+        }
+        return None<T>();
+      }
+      WaitForData();
+    }
+  }
+
+  // Wakes up both threads; Put does nothing afterwards and Take returns what
+  // is left before returning None.
+  void Close() {
+    is_closed_ = true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  bool is_closed() const { return is_closed_; }
+
+  // Approximate when called while either thread is active.
+  size_t size() const { return tail_.load() - head_.load(); }
+
+  size_t capacity() const { return capacity_; }
+
+  // The number of elements discarded because the buffer was full.
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  static const size_t kCacheLineSize = 64;
+  // Bounds how long a partial batch can wait for the consumer.
+  static constexpr std::chrono::microseconds kMaxWait = std::chrono::microseconds(1000);
+
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  bool TryPush(T* value) {
+    const size_t position = tail_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[position & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != position) {
+      return false; // Full, or the consumer has not finished with the slot.
+    }
+    slot.value = std::move(*value);
+    slot.sequence.store(position + 1, std::memory_order_release);
+    tail_.store(position + 1);
+    return true;
+  }
+
+  // Called by the consumer and, to drop the oldest element, by the producer,
+  // so the head is claimed with a compare and swap.
+  bool TryPop(T* value) {
+    size_t position = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[position & mask_];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+      if (difference == 0) {
+        if (head_.compare_exchange_weak(position, position + 1)) {
+          *value = std::move(slot.value);
+          slot.sequence.store(position + capacity_, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false; // Empty.
+      } else {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void WaitForData() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    consumer_waiting_ = true;
+    not_empty_.wait_for(lock, kMaxWait, [this]() {
+      return size() >= wake_batch_ || is_closed();
+    });
+    consumer_waiting_ = false;
+  }
+
+  void WaitForSpace() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    producer_waiting_ = true;
+    not_full_.wait_for(lock, kMaxWait, [this]() {
+      return size() < capacity_ || is_closed();
+    });
+    producer_waiting_ = false;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  const OverflowPolicy policy_;
+  const size_t wake_batch_;
+  std::vector<Slot> slots_;
+
+  // The producer and consumer indices are kept on separate cache lines so the
+  // two threads do not invalidate each other's line on every access. They are
+  // padded a line apart rather than aligned, since before C++17 new does not
+  // honour over-aligned types, which every consumer holding a RingBuffer would
+  // become.
+  char tail_padding_[kCacheLineSize];
+  std::atomic<size_t> tail_{0};
+  std::atomic<uint64_t> dropped_{0};
+  char head_padding_[kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(std::atomic<uint64_t>)];
+  std::atomic<size_t> head_{0};
+  char flags_padding_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  std::atomic<bool> is_closed_{false};
+  std::atomic<bool> consumer_waiting_{false};
+  std::atomic<bool> producer_waiting_{false};
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+};
+
+template <typename T>
+constexpr std::chrono::microseconds RingBuffer<T>::kMaxWait;
+
+} // namespace utility
+
+#endif // TURBO_SANTA_COMMON_UTILITY_RING_BUFFER_H_
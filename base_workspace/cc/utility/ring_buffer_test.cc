@@ -0,0 +1,106 @@
+#include <thread>
+#include <vector>
+
+#include "cc/utility/ring_buffer.h"
+#include "gtest/gtest.h"
+
+namespace utility {
+
+using std::vector;
+
+TEST(RingBufferTest, RoundsCapacityUpToPowerOfTwo) {
+  RingBuffer<int> buffer(5, RingBuffer<int>::BLOCK);
+  EXPECT_EQ(8u, buffer.capacity());
+}
+
+TEST(RingBufferTest, TakesInOrder) {
+  RingBuffer<int> buffer(4, RingBuffer<int>::BLOCK);
+  buffer.Put(1);
+  buffer.Put(2);
+  buffer.Put(3);
+  EXPECT_EQ(3u, buffer.size());
+  EXPECT_EQ(1, buffer.Take().get());
+  EXPECT_EQ(2, buffer.Take().get());
+  EXPECT_EQ(3, buffer.Take().get());
+  EXPECT_EQ(0u, buffer.size());
+}
+
+TEST(RingBufferTest, DropNewest) {
+  RingBuffer<int> buffer(2, RingBuffer<int>::DROP_NEWEST);
+  buffer.Put(1);
+  buffer.Put(2);
+  buffer.Put(3);
+  EXPECT_EQ(1u, buffer.dropped());
+  EXPECT_EQ(1, buffer.Take().get());
+  EXPECT_EQ(2, buffer.Take().get());
+}
+
+TEST(RingBufferTest, DropOldest) {
+  RingBuffer<int> buffer(2, RingBuffer<int>::DROP_OLDEST);
+  buffer.Put(1);
+  buffer.Put(2);
+  buffer.Put(3);
+  EXPECT_EQ(1u, buffer.dropped());
+  EXPECT_EQ(2, buffer.Take().get());
+  EXPECT_EQ(3, buffer.Take().get());
+}
+
+TEST(RingBufferTest, CloseDrainsThenReturnsNone) {
+  RingBuffer<int> buffer(4, RingBuffer<int>::BLOCK);
+  buffer.Put(1);
+  buffer.Close();
+  buffer.Put(2);
+  EXPECT_EQ(1, buffer.Take().get());
+  EXPECT_FALSE(buffer.Take().is_present());
+}
+
+TEST(RingBufferTest, CloseWakesConsumer) {
+  RingBuffer<int> buffer(4, RingBuffer<int>::BLOCK);
+  std::thread consumer([&buffer]() { EXPECT_FALSE(buffer.Take().is_present()); });
+  buffer.Close();
+  consumer.join();
+}
+
+TEST(RingBufferTest, BlockingProducerLosesNothing) {
+  const int kCount = 100000;
+  RingBuffer<int> buffer(16, RingBuffer<int>::BLOCK);
+  vector<int> taken;
+  std::thread consumer([&buffer, &taken]() {
+    for (int i = 0; i < kCount; i++) {
+      taken.push_back(buffer.Take().get());
+    }
+  });
+  for (int i = 0; i < kCount; i++) {
+    buffer.Put(i);
+  }
+  consumer.join();
+  ASSERT_EQ(static_cast<size_t>(kCount), taken.size());
+  for (int i = 0; i < kCount; i++) {
+    ASSERT_EQ(i, taken[i]);
+  }
+  EXPECT_EQ(0u, buffer.dropped());
+}
+
+TEST(RingBufferTest, DroppingProducerStaysInOrder) {
+  const int kCount = 100000;
+  RingBuffer<int> buffer(16, RingBuffer<int>::DROP_OLDEST);
+  vector<int> taken;
+  std::thread consumer([&buffer, &taken]() {
+    Option<int> value;
+    while ((value = buffer.Take()).is_present()) {
+      taken.push_back(value.get());
+    }
+  });
+  for (int i = 0; i < kCount; i++) {
+    buffer.Put(i);
+  }
+  buffer.Close();
+  consumer.join();
+  EXPECT_EQ(static_cast<uint64_t>(kCount), taken.size() + buffer.dropped());
+  for (size_t i = 1; i < taken.size(); i++) {
+    ASSERT_LT(taken[i - 1], taken[i]);
+  }
+  EXPECT_EQ(kCount - 1, taken.back());
+}
+
+} // namespace utility
@@ -21,4 +21,12 @@ public class Clocktroller {
   public native void pause();
 
   public native void kill();
+
+  // Profiles every memory access while enabled; the counts are kept across
+  // calls and written out by writeMemoryProfile.
+  public native void setMemoryProfiling(boolean enabled);
+
+  // Writes the memory profile so far to path as CSV and returns whether it
+  // could.
+  public native boolean writeMemoryProfile(String path);
 }
@@ -1,18 +1,33 @@
 #include "java/com/turbosanta/backend/clocktroller/com_turbosanta_backend_clocktroller_Clocktroller.h"
 
-#include <vector>
+#include <memory>
+#include <string>
 #include "cc/backend/clocktroller/clocktroller.h"
+#include "cc/backend/graphics/presenter.h"
 #include "cc/backend/graphics/screen.h"
+#include "cc/backend/memory/mbc/rom_image.h"
 #include "java/com/turbosanta/backend/graphics/screen.h"
 #include "java/com/turbosanta/backend/handle.h"
 #include "glog/logging.h"
 
-using std::vector;
+using std::shared_ptr;
 using backend::clocktroller::Clocktroller;
+using backend::debug::memory_profiler::MemoryProfiler;
+using backend::graphics::Presenter;
+using backend::memory::ROMImage;
 using java_com_turbosanta_backend::graphics::Screen;
 using java_com_turbosanta_backend::setHandle;
 using java_com_turbosanta_backend::getHandle;
 
+// What the java object's handle points to. The Presenter draws frames on a
+// thread of its own, so that the emulation never waits on the JVM.
+struct NativeClocktroller {
+  NativeClocktroller(Screen* screen) : presenter(screen), clocktroller(screen) {}
+
+  Presenter presenter;
+  Clocktroller clocktroller;
+};
+
 Screen* GetScreen(JNIEnv* env, jobject clocktroller_obj) {
   jclass clocktroller_class = env->GetObjectClass(clocktroller_obj);
   jfieldID screen_fid = env->GetFieldID(clocktroller_class, "screen", "Lcom/turbosanta/backend/graphics/Screen;");
@@ -22,29 +37,45 @@ Screen* GetScreen(JNIEnv* env, jobject clocktroller_obj) {
 
 void Java_com_turbosanta_backend_clocktroller_Clocktroller_init(JNIEnv* env, jobject obj, jbyteArray rom, jlong length) {
   // Create clocktroller.
-  Clocktroller* clocktroller = new Clocktroller(GetScreen(env, obj));
+  NativeClocktroller* native = new NativeClocktroller(GetScreen(env, obj));
+  Clocktroller* clocktroller = &native->clocktroller;
   google::InstallFailureSignalHandler();
 
-  // Init with ROM data.
-  vector<uint8_t> buffer(length);
-  env->GetByteArrayRegion(rom, 0, length, reinterpret_cast<jbyte*>(buffer.data()));
-  clocktroller->Init(buffer.data(), length);
+  // Init with ROM data, copied straight into the image the MBC keeps.
+  shared_ptr<ROMImage> image = ROMImage::Allocate(length);
+  env->GetByteArrayRegion(rom, 0, length, reinterpret_cast<jbyte*>(image->data()));
+  clocktroller->Init(image);
+  clocktroller->AttachPresenter(&native->presenter);
 
   // Store pointer to clocktroller in java object.
-  setHandle<Clocktroller>(env, obj, clocktroller);
+  setHandle<NativeClocktroller>(env, obj, native);
 }
 
 void Java_com_turbosanta_backend_clocktroller_Clocktroller_run(JNIEnv* env, jobject obj) {
-  Clocktroller* clocktroller = getHandle<Clocktroller>(env, obj);
+  Clocktroller* clocktroller = &getHandle<NativeClocktroller>(env, obj)->clocktroller;
   clocktroller->Run();
 }
 
 void Java_com_turbosanta_backend_clocktroller_Clocktroller_pause(JNIEnv* env, jobject obj) {
-  Clocktroller* clocktroller = getHandle<Clocktroller>(env, obj);
+  Clocktroller* clocktroller = &getHandle<NativeClocktroller>(env, obj)->clocktroller;
   clocktroller->Pause();
 }
 
 void Java_com_turbosanta_backend_clocktroller_Clocktroller_kill(JNIEnv* env, jobject obj) {
-  Clocktroller* clocktroller = getHandle<Clocktroller>(env, obj);
+  Clocktroller* clocktroller = &getHandle<NativeClocktroller>(env, obj)->clocktroller;
   clocktroller->Kill();
+  getHandle<NativeClocktroller>(env, obj)->presenter.Stop();
+}
+
+void Java_com_turbosanta_backend_clocktroller_Clocktroller_setMemoryProfiling(JNIEnv* env, jobject obj, jboolean enabled) {
+  Clocktroller* clocktroller = &getHandle<NativeClocktroller>(env, obj)->clocktroller;
+  clocktroller->set_memory_profiling(enabled);
+}
+
+jboolean Java_com_turbosanta_backend_clocktroller_Clocktroller_writeMemoryProfile(JNIEnv* env, jobject obj, jstring path) {
+  Clocktroller* clocktroller = &getHandle<NativeClocktroller>(env, obj)->clocktroller;
+  const char* path_chars = env->GetStringUTFChars(path, nullptr);
+  std::string path_string(path_chars);
+  env->ReleaseStringUTFChars(path, path_chars);
+  return clocktroller->memory_profiler()->WriteSnapshot(path_string, MemoryProfiler::CSV);
 }
@@ -39,6 +39,22 @@ JNIEXPORT void JNICALL Java_com_turbosanta_backend_clocktroller_Clocktroller_pau
 JNIEXPORT void JNICALL Java_com_turbosanta_backend_clocktroller_Clocktroller_kill
   (JNIEnv *, jobject);
 
+/*
+ * Class:     com_turbosanta_backend_clocktroller_Clocktroller
+ * Method:    setMemoryProfiling
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_com_turbosanta_backend_clocktroller_Clocktroller_setMemoryProfiling
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     com_turbosanta_backend_clocktroller_Clocktroller
+ * Method:    writeMemoryProfile
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_turbosanta_backend_clocktroller_Clocktroller_writeMemoryProfile
+  (JNIEnv *, jobject, jstring);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,11 +2,15 @@ package com.turbosanta.backend.graphics;
 
 import java.awt.Graphics;
 import java.awt.image.BufferedImage;
+import java.awt.image.DataBufferByte;
 import java.lang.Runnable;
 import javax.swing.SwingUtilities;
 
 public class Screen {
   private BufferedImage image;
+  // The backing array of image; the native side writes each frame into it
+  // directly.
+  private byte[] pixels;
   private DrawableArea screen;
   private long nativeHandle;
 
@@ -21,6 +25,7 @@ public class Screen {
         getHeight(), 
         BufferedImage.TYPE_BYTE_GRAY
     );
+    pixels = ((DataBufferByte) image.getRaster().getDataBuffer()).getData();
   }
 
   public native void init();
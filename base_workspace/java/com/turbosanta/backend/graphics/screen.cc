@@ -1,5 +1,9 @@
 #include "java/com/turbosanta/backend/graphics/screen.h"
 
+#include <cmath>
+
+#include "glog/logging.h"
+
 namespace java_com_turbosanta_backend {
 namespace graphics {
 namespace {
@@ -20,23 +24,76 @@ jobject GetImageJObject(JNIEnv* env, jobject obj) {
   return env->GetObjectField(obj, fieldID);
 }
 
+jbyteArray GetPixelsJObject(JNIEnv* env, jobject obj) {
+  jclass klass = env->GetObjectClass(obj);
+  jfieldID fieldID = env->GetFieldID(klass, "pixels", "[B");
+  return static_cast<jbyteArray>(env->GetObjectField(obj, fieldID));
+}
+
 jmethodID GetDrawMethodID(JNIEnv* env, jobject obj) {
   jclass klass = env->GetObjectClass(obj);
   return env->GetMethodID(klass, "draw", "()V");
 }
+
+// An sRGB component, from 0 to 1, in linear light.
+double SRGBToLinear(double component) {
+  if (component <= 0.04045) {
+    return component / 12.92;
+  }
+  return std::pow((component + 0.055) / 1.055, 2.4);
+}
+
+// The gray byte setRGB stores in a TYPE_BYTE_GRAY image for each shade Set
+// passes it. Set packs 0xff - shade into red and green, with blue at 0xff,
+// and the image keeps the luminance of that color in linear gray.
+class GrayTable {
+ public:
+  GrayTable() {
+    for (int shade = 0; shade < 0x100; shade++) {
+      const double value = SRGBToLinear((0xff - shade) / 255.0);
+      const double gray = 0.2125 * value + 0.7154 * value + 0.0721 * SRGBToLinear(1.0);
+      gray_[shade] = static_cast<uint8_t>(gray * 0xff + 0.5);
+    }
+  }
+
+  uint8_t operator[](uint8_t shade) const { return gray_[shade]; }
+
+ private:
+  uint8_t gray_[0x100];
+};
+
+const GrayTable kGrayTable;
 } // namespace
 
-ScreenRaster::ScreenRaster(JavaVM* jvm, JNIEnv* env, jobject image) :
+ScreenRaster::ScreenRaster(JavaVM* jvm, JNIEnv* env, jobject image, jbyteArray pixels) :
     jvm_(jvm),
     image_(env->NewGlobalRef(image)),
+    pixels_(static_cast<jbyteArray>(env->NewGlobalRef(pixels))),
     getMID_(GetGetMethodID(env, image_)),
     setMID_(GetSetMethodID(env, image_)) {}
 
+void ScreenRaster::SetFrame(const uint8_t* frame) {
+  JNIEnv* env;
+  jvm_->AttachCurrentThread((void**) &env, nullptr);
+  // Pins the array instead of copying it; nothing may call back into Java
+  // until it is released.
+  uint8_t* pixels = static_cast<uint8_t*>(env->GetPrimitiveArrayCritical(pixels_, nullptr));
+  if (pixels == nullptr) {
+    LOG(ERROR) << "Unable to access the pixels of the screen.";
+    return;
+  }
+  for (int i = 0; i < kScreenWidth * kScreenHeight; i++) {
+    // Same conversion as Set, where 0 is white.
+    pixels[i] = kGrayTable[frame[i]];
+  }
+  env->ReleasePrimitiveArrayCritical(pixels_, pixels, 0);
+}
+
 Screen::Screen(JavaVM* jvm, JNIEnv* env, jobject screen) : 
     jvm_(jvm),
     screen_(env->NewGlobalRef(screen)),
     drawMID_(GetDrawMethodID(env, screen)),
-    raster_(jvm, env, env->NewGlobalRef(GetImageJObject(env, screen))) {}
+    raster_(jvm, env, GetImageJObject(env, screen), GetPixelsJObject(env, screen)) {}
 
 } // namespace graphics
 } // namespace java_com_turbosanta_backend
@@ -10,7 +10,7 @@ namespace graphics {
 
 class ScreenRaster : public backend::graphics::ScreenRaster {
  public:
-  ScreenRaster(JavaVM* jvm, JNIEnv* env, jobject image);
+  ScreenRaster(JavaVM* jvm, JNIEnv* env, jobject image, jbyteArray pixels);
 
   uint8_t Get(uint32_t y, uint32_t x) const override {
     JNIEnv* env;
@@ -35,9 +35,15 @@ class ScreenRaster : public backend::graphics::ScreenRaster {
     env->CallVoidMethodA(image_, setMID_, reinterpret_cast<const jvalue*>(&args));
   }
 
+  // Writes the whole frame straight into the image's pixels in one go rather
+  // than crossing into Java for every pixel.
+  void SetFrame(const uint8_t* frame) override;
+
  private:
   JavaVM* jvm_;
   jobject image_;
+  // The backing array of image, which is 8-bit gray.
+  jbyteArray pixels_;
   jmethodID getMID_;
   jmethodID setMID_;
 };